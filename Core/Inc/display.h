@@ -25,6 +25,9 @@ extern uint32_t MainColourFore;
 extern uint32_t AuxColourFore;
 extern uint32_t AnnunColourFore;
 extern _Bool oneVoltmode;
+extern uint16_t renderCellsRedrawn;
+extern uint16_t renderCellsSkipped;
+extern _Bool glyphAtlasReady;
 
 extern uint32_t LCD_VBPD;
 extern uint32_t LCD_VFPD;
@@ -40,6 +43,8 @@ void DisplayMain(void);
 void DisplayAuxFirstHalf(void);
 void DisplayAuxSecondHalf(void);
 void DisplayAnnunciatorsHalf(void);
+void DisplayInvalidate(void);
+void DisplayAtlasInit(void);
 
 
 // Settings suited for 400x960 TFT LCD (320x960 physical)
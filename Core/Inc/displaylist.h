@@ -0,0 +1,62 @@
+/**
+  ******************************************************************************
+  * @file    displaylist.h
+  * @brief   This file contains all the function prototypes for
+  *          the displaylist.c file
+  ******************************************************************************
+*/
+
+#ifndef DISPLAYLIST_H
+#define DISPLAYLIST_H
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Display list size, entries per list (3 bytes each). Two lists are used, one being recorded while the other is sent.
+// A list that fills up is sent and recording carries on in the other list.
+#define DL_ENTRIES				256
+
+// Longest an LT7680 status poll may take before it gives up, display list and blocking alike (LT_WaitIdle(),
+// LT_WaitVsync(), DrawText() and the text FIFO depth learning), DWT timed by LT_WaitTimedOut()
+#define LT_WAIT_TIMEOUT_US		20000
+
+// Display list status polls: time between read frames while a condition is not met yet (TIM3).
+// The VSYNC wait is up to a panel frame long and only needs to land inside the vertical blank.
+#define LT_POLL_INTERVAL_US		20
+#define LT_VSYNC_POLL_US		100
+
+// Display list entry opcodes
+#define DL_OP_FRAME				0x01		// Send one 2-byte SPI frame (control byte, data byte) in its own CS cycle
+#define DL_OP_WAIT_REG			0x02		// Read an LT7680 register until (value & mask) == 0
+#define DL_OP_DELAY				0x03		// Pause the list for n ms (resumed from SysTick, the CPU is not held)
+#define DL_OP_WAIT_STATUS		0x04		// Read the status register (STSR) until (status & mask) == value
+#define DL_OP_WAIT_REG_SET		0x05		// Read an LT7680 register until (value & mask) != 0
+
+// Externally accessible variables
+extern volatile uint8_t SPI1_TX_completed_flag;	// Fence, 1 = no display list in flight
+extern _Bool displayListRecording;
+extern uint16_t displayListEntriesPeak;
+extern uint32_t displayListOverflows;
+extern uint32_t displayListWaitsMerged;
+extern volatile uint32_t ltWaitTimeouts;
+
+// Function prototypes
+void LT_DisplayListInit(void);
+void LT_DisplayListBegin(void);
+void LT_DisplayListEnd(void);
+void LT_DisplayListWait(void);
+void LT_DisplayListFlush(void);
+void LT_DisplayListFrame(uint8_t control, uint8_t data);
+void LT_DisplayListWaitReg(uint8_t reg, uint8_t mask);
+void LT_DisplayListWaitStatus(uint8_t mask, uint8_t value);
+void LT_DisplayListWaitRegSet(uint8_t reg, uint8_t mask);
+void LT_Delay(uint32_t ms);
+void LT_WaitIdle(void);
+void LT_WaitVsync(void);
+_Bool LT_WaitTimedOut(uint32_t start);
+void LT_DisplayListIRQHandler(void);
+void TIM3_IRQHandler(void);
+void LT_DisplayListTick(void);
+
+#endif // DISPLAYLIST_H
@@ -6,6 +6,18 @@
   ******************************************************************************
 */
 
-// It's lonely here!
+#ifndef LCD_H
+#define LCD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Function prototypes
+void LCD_SPI_Write(uint16_t data, uint8_t bits);
+void LCDWriteRegister(uint8_t reg);
+void LCDWriteData(uint8_t data);
+_Bool LCD_Init(const char* name);
+
+#endif // LCD_H
 
 
@@ -23,6 +23,104 @@ uint8_t ReadStatus(void);
 uint8_t ReadData(void);
 void WriteDataToRegister(uint8_t reg, uint8_t value);
 
+// SPI traffic counters, every CS cycle to the LT7680 whether blocking or from the display list
+extern volatile uint32_t ltSpiBytes;
+extern volatile uint32_t ltSpiTransactions;
+#define LT_COUNT_FRAME(bytes)	do { ltSpiBytes += (bytes); ltSpiTransactions++; } while (0)
+
+// Host simulator build (Tools/sim): every SPI1 frame goes to the LT7680 register model instead of the bus.
+// Set from the sim Makefile, 0 for the firmware.
+#ifndef LT_HOST_SIM
+#define LT_HOST_SIM				0
+#endif
+#if LT_HOST_SIM
+uint8_t LtSim_Frame(uint8_t control, uint8_t data);	// One CS cycle, returns the byte clocked in during 'data'
+#endif
+
+// SPI1 clock auto-tune: each prescaler from LT_SPI_PRESCALER_SAFE down to SPI_BAUDRATEPRESCALER_2 must pass
+// LT_SPI_ROUND_TRIPS write / read-back round trips to a scratch register, one step slower than the fastest to
+// pass is kept
+#define LT_SPI_PRESCALER_SAFE	SPI_BAUDRATEPRESCALER_8	// 9 MHz, the original fixed rate
+#define LT_SPI_SCRATCH_REG		0x88	// TCMPB0, Timer-0 compare, unused (the backlight is Timer-1), restored after the test
+#define LT_SPI_ROUND_TRIPS		64
+extern uint32_t ltSpiPrescaler;
+extern uint32_t ltSpiLinkErrors;
+_Bool LT_SpiLinkTest(uint16_t trips);
+uint32_t LT_SpiAutoTune(uint32_t stored);
+
+// SPI1 frame microbenchmark, cycles per 2-byte CS frame: the register level transfers against the HAL calls
+// they replaced, at the tuned clock. Run once at boot by LT_SpiBenchmark().
+// Set to 1 to build it in for a LIVE WATCH session, 0 for normal use (no boot time or RAM spent on it).
+#define LT_SPI_BENCH_ENABLE		0
+
+#if LT_SPI_BENCH_ENABLE
+#define LT_SPI_BENCH_FRAMES		32
+typedef struct {
+	uint32_t halWrite;			// HAL_GPIO_WritePin() + HAL_SPI_Transmit(), as WriteRegister() / WriteData() were
+	uint32_t halRead;			// HAL_GPIO_WritePin() + HAL_SPI_Transmit() + HAL_SPI_Receive(), as ReadStatus() was
+	uint32_t regWrite;			// WriteRegister() now
+	uint32_t regRead;			// ReadStatus() now
+	uint32_t prescaler;			// SPI1 BR bits it was measured at
+} LtSpiBench;
+extern LtSpiBench ltSpiBench;	// LIVE WATCH
+void LT_SpiBenchmark(void);
+#endif // LT_SPI_BENCH_ENABLE
+
+// Command lists - (register, value) pairs sent as one batch
+#define LT_CMDLIST_MAX_PAIRS	16		// Pairs held before the list is sent automatically
+void LT_CmdListBegin(void);
+void LT_CmdListAdd(uint8_t reg, uint8_t value);
+void LT_CmdListSend(void);
+
+// STSR status register bits (ReadStatus)
+#define STSR_WFIFO_FULL			0x80	// Host memory write FIFO full
+#define STSR_WFIFO_EMPTY		0x40	// Host memory write FIFO empty
+#define STSR_RFIFO_FULL			0x20	// Host memory read FIFO full
+#define STSR_RFIFO_EMPTY		0x10	// Host memory read FIFO empty
+#define STSR_CORE_BUSY			0x08	// Core task busy
+#define STSR_SDRAM_READY		0x04	// SDRAM ready for access
+#define STSR_INHIBIT			0x02	// Operation inhibited, reset / power-on initialisation still running
+
+// Bring-up poll limits (ms), each no longer than the fixed delay it replaced
+#define LT_RESET_PULSE_MS		1		// LCM_RESET held low
+#define LT_RESET_READY_MS		100		// Reset released until STSR_INHIBIT clears
+#define LT_PLL_LOCK_MS			10		// PLL reconfigure until REG[00h] bit 7 reads back 1
+#define LT_SDRAM_READY_MS		20		// SDRAM init until REG[E4h] bit 0 and STSR_SDRAM_READY
+
+// Text FIFO
+#define LT_TEXT_FIFO_MAX		64		// Upper limit for the learned burst length
+extern uint8_t textFifoBurst;
+void LT_TextFifoLearnDepth(void);
+void DrawText(const char* text);
+
+// User-defined characters, uploaded once at boot by LT_UcgInit()
+#define LT_UCG_16X32			0		// MAIN size
+#define LT_UCG_12X24			1		// AUX size
+#define LT_UCG_SIZES			2
+#define LT_UCG_CGRAM_ADDR		0x00200000	// SDRAM address of CGRAM, clear of the display canvases
+void LT_UcgInit(void);
+int16_t LT_UcgCode(char c, uint8_t size);
+void LT_UcgDraw(int16_t code);
+
+// Geometric drawing engine, corners inclusive, RGB colour
+void DrawLine(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE);
+void FillRect(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE);
+void DrawRect(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE);
+
+// Canvas selection and BTE memory copy between images in SDRAM (16bpp)
+void LT_SetCanvas(uint32_t address, uint16_t width, uint16_t height);
+void LT_BteSetup(uint32_t srcAddress, uint16_t srcWidth, uint32_t dstAddress, uint16_t dstWidth);
+void LT_BteCopy(uint16_t srcX, uint16_t srcY, uint16_t dstX, uint16_t dstY, uint16_t width, uint16_t height);
+
+// Double buffering, MAIN_IMAGE_START and BACK_IMAGE_START, flipped by MISA at vertical blank
+#define LT_PAGE_DIRTY_MAX		8		// Dirty rectangles per pass before the whole page is synced instead
+#define LT_INT_VSYNC			0x10	// REG[0Bh] INTEN / REG[0Ch] INTF: VSYNC time base (flag write 1 to clear)
+extern uint32_t ltPageFlips;
+void LT_PageInit(void);
+uint32_t LT_PageDrawn(void);
+void LT_PageDirty(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void LT_PageFlip(void);
+
 // Testing routines
 //void OriginalFillSDRAM_LT(void);
 //void BootClearToRed(void);
@@ -43,11 +141,13 @@ void FillDisplayRAM(void);
 // LT7680 Commands and Configuration
 void SoftwareReset(void);
 void SetBacklightFull(void);
+void ConfigurePWMAndSetBrightness(uint8_t brightnessPercentage);
 void FillScreen(uint32_t color);
 void SendAllToLT7680_LT(void);
 //void SetBackgroundColor(color);
 void Text_Mode(void);
 void SetTextColors(uint32_t foreground, uint32_t background);
+void SetTextCursor(uint16_t x, uint16_t y);
 //void SetFontTypeSize(uint8_t fontType, uint8_t fontSize);
 //void SetTextCursor(uint16_t x, uint16_t y);
 //void DrawText(char* text);
@@ -83,7 +183,7 @@ void ResetGraphicWritePosition_LT(void);
 void SetGraphicRWYCoordinate_LT(void);
 void SetCanvasStartAddress_LT(void);
 void SetCanvasImageWidth_LT(void);
-//void ClearScreen(void);
+void ClearScreen(void);
 
 // Pin definitions for LT7680 controller
 // The SCK, MOSI, MISO, and CS pins are defined and configured as part of the SPI peripheral initialization in the STM32 HAL driver setup.
@@ -148,6 +248,8 @@ extern uint32_t REFRESH_RATE;
 #define REG_TEXT_CURSOR_X       0x20		// X-coordinate of text cursor
 #define REG_TEXT_CURSOR_Y       0x21		// Y-coordinate of text cursor
 #define MAIN_IMAGE_START		0x000000	// Main image start address set to 0 (MISA)			0x20004000
+#define BACK_IMAGE_START		0x100000	// Second canvas for double buffering (a canvas is 0xBB800 bytes)
+#define ATLAS_IMAGE_START		0x400000	// Off-screen glyph atlas, see display.c
 #define PD_OUTPUT_SEQ			0b000		// Parallel PD[23:0] Output Sequence				RGB
 
 // User
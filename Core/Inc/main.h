@@ -24,9 +24,25 @@ uint32_t EEPROM_ReadData(uint32_t address);											// Prototype for uint32_t
 HAL_StatusTypeDef EEPROM_Write4CharString(uint32_t address, const char* str);		// Prototype for CHAR write
 void EEPROM_Read4CharString(uint32_t address, char* buffer);						// Prototype for CHAR read
 HAL_StatusTypeDef EEPROM_ErasePage(uint32_t address);								// Prototype for Erase
+void EEPROM_SaveSettings(void);														// Erase and write all the settings
+
+/* Exported types ------------------------------------------------------------*/
+// VFD 5x7 character bitmap and the character it decodes to
+typedef struct {
+	uint8_t bitmap[7]; // 7 bytes for 5x7 character bitmaps
+	char ascii;        // Corresponding ASCII character
+} BitmapChar;
+
+extern const BitmapChar bitmap_characters[];
+extern const uint16_t bitmapCharCount;		// Entries in bitmap_characters[]
 
 /* Exported functions prototypes ---------------------------------------------*/
 void Error_Handler(void);
+void BitmapLookup_Init(void);
+char BitmapToChar(const uint8_t* bitmap);
+void Packets_to_chars(void);
+void Main_Aux_R6581(void);
+void RenderPass(_Bool rendered);
 
 /* Private defines -----------------------------------------------------------*/
 #define TEST_OUT_Pin GPIO_PIN_13				// PC13 - LED
@@ -89,6 +105,10 @@ void DelayMicroseconds(uint16_t us);
 #define LCD_SCK_Port  GPIOB
 #define LCD_SDI_Port  GPIOB
 
+// ST7701S 3-wire serial write timing used by the bit bang, datasheet minimums plus margin
+#define LCD_SCL_HALF_NS		60			// SCL low and high time, i.e. 120 ns / ~8 MHz per bit
+#define LCD_CS_GUARD_NS		60			// CSX setup before the first edge, hold after the last, and high time between words
+
 	
 	
 	
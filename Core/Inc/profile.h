@@ -0,0 +1,81 @@
+/**
+  ******************************************************************************
+  * @file    profile.h
+  * @brief   This file contains all the function prototypes for
+  *          the profile.c file
+  ******************************************************************************
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "stm32f1xx.h"
+#include <stdint.h>
+
+// Pipeline stages timed with the DWT cycle counter
+typedef enum {
+	PROF_EXTI = 0,				// EXTI15_10_IRQHandler, SPI2 capture restart
+	PROF_PACKETS_TO_CHARS,
+	PROF_MAIN_AUX,				// Main_Aux_R6581()
+	PROF_SPLASH,				// DisplaySplash()
+	PROF_DISPLAY_MAIN,			// DisplayMain()
+	PROF_DISPLAY_AUX,			// DisplayAux()
+	PROF_ANNUNCIATORS,			// DisplayAnnunciators()
+	PROF_RIGHT_WIPE,			// Right wipe FillRect() in main()
+	PROF_STAGES
+} ProfileStageId;
+
+#define PROFILE_HIST_BINS		24		// Bin n counts times of 2^n to 2^(n+1)-1 cycles, the last bin everything above
+
+typedef struct {
+	uint32_t count;				// Times run
+	uint32_t last;				// Cycles, last run
+	uint32_t min;
+	uint32_t max;
+	uint32_t mean;				// Rolling mean, about the last 16 runs
+	uint64_t total;				// For the long-term mean, total / count
+	uint16_t hist[PROFILE_HIST_BINS];	// log2 histogram, saturates at 65535
+} ProfileStage;
+
+typedef struct {
+	uint32_t coreHz;			// SystemCoreClock, cycles to time: us = cycles / (coreHz / 1000000)
+	ProfileStage stage[PROF_STAGES];
+} ProfileData;
+
+// Boot phases, in the order main() runs them
+typedef enum {
+	BOOT_HAL_INIT = 0,			// HAL_Init()
+	BOOT_CLOCK,					// SystemClock_Config()
+	BOOT_PERIPHERALS,			// GPIO, DMA, SPI, timer, lookup tables, CRC and DWT
+	BOOT_LT_RESET,				// HardwareReset()
+	BOOT_LT_SETUP,				// SendAllToLT7680_LT() and the SPI1 clock auto-tune
+	BOOT_CLEAR,					// ClearScreen() after the backlight is on
+	BOOT_EEPROM,				// Settings load
+	BOOT_LCD_INIT,				// LCD_Init(), ST7701S glass
+	BOOT_PHASES
+} BootPhaseId;
+
+typedef struct {
+	uint32_t us[BOOT_PHASES];	// Time taken by each phase
+	uint32_t at[BOOT_PHASES];	// Time since reset when each phase finished, gaps between phases included
+} BootLog;
+
+// Externally accessible variables
+extern volatile ProfileData profile;	// LIVE WATCH, or read by a host script through the debugger
+extern BootLog bootLog;					// LIVE WATCH, and on the splash screen
+
+// Time a stage: uint32_t t = PROFILE_START(); ... PROFILE_STOP(PROF_xxx, t);
+#define PROFILE_START()			(DWT->CYCCNT)
+#define PROFILE_STOP(id, start)	Profile_Record((id), DWT->CYCCNT - (start))
+
+// Time a boot phase: uint32_t t = BOOT_START(); ... Boot_Record(BOOT_xxx, t);
+#define BOOT_START()			(DWT->CYCCNT)
+
+// Function prototypes
+void Boot_Init(void);
+void Boot_Record(BootPhaseId id, uint32_t start);
+void Profile_Init(void);
+void Profile_Record(ProfileStageId id, uint32_t cycles);
+void Profile_Reset(void);
+
+#endif // PROFILE_H
@@ -0,0 +1,45 @@
+/**
+  ******************************************************************************
+  * @file    vfdcapture.h
+  * @brief   This file contains all the function prototypes for
+  *          the vfdcapture.c file
+  ******************************************************************************
+*/
+
+#ifndef VFDCAPTURE_H
+#define VFDCAPTURE_H
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Number of VFD capture buffers: one being filled by DMA, one holding the newest complete frame, one being decoded
+#define VFD_CAPTURE_BUFFERS		3
+
+// Frame event queue length (ISR to main loop). One slot is kept free to tell full from empty.
+#define VFD_QUEUE_LEN			8
+
+// Externally accessible variables
+extern uint8_t vfdReplayFrame[];
+extern volatile uint8_t vfdReplayMode;
+extern volatile uint32_t vfdReplayRequest;
+extern volatile uint32_t vfdFrameSeq;		// Sequence number of the last complete frame published by the ISR
+extern uint32_t vfdDecodeSeq;				// Sequence number of the frame being decoded
+extern uint32_t vfdDecodeCapturedAt;		// DWT cycle count when that frame's capture completed
+extern uint32_t vfdFramesDropped;			// Complete frames overwritten before the main loop took them (LIVE WATCH)
+extern uint32_t vfdQueueOverflows;			// Frame events lost because the queue was full (LIVE WATCH)
+extern uint32_t vfdCrcHits;					// Frames identical to the previous one, decode and render skipped (LIVE WATCH)
+extern uint32_t vfdCrcMisses;				// Frames that changed (LIVE WATCH)
+
+// Function prototypes
+void VFD_CaptureInit(void);
+uint8_t* VFD_CaptureStart(void);
+void VFD_CapturePublish(void);
+_Bool VFD_CaptureAcquire(void);
+const uint8_t* VFD_CaptureFrame(void);
+_Bool VFD_FrameQueuePop(uint32_t* seq);
+_Bool VFD_FrameQueueEmpty(void);
+_Bool VFD_CaptureChanged(void);
+void VFD_CaptureReplayPoll(void);
+
+#endif // VFDCAPTURE_H
@@ -0,0 +1,47 @@
+/**
+  ******************************************************************************
+  * @file    vfdrecord.h
+  * @brief   This file contains all the function prototypes for
+  *          the vfdrecord.c file
+  ******************************************************************************
+*/
+
+#ifndef VFDRECORD_H
+#define VFDRECORD_H
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Raw VFD frame recorder, streams every captured frame out of USART2 TX (PA2) at 921600 baud 8N1.
+// Set to 1 to build it in, 0 for normal use (PA2 is then left alone and no RAM is used).
+#define VFD_RECORD_ENABLE		0
+
+#define VFD_RECORD_BAUD			921600
+#define VFD_RECORD_RING			2048		// Bytes of RAM for records waiting to go out
+#define VFD_RECORD_RUN_MAX		111			// Repeat run written out after ~1 s of unchanged frames
+
+// Record layout, all little-endian, read by Tools/vfd_record_decode.py:
+//   0xA5, type, tick (4, HAL_GetTick ms), seq (2, low 16 bits of the frame sequence number), body, check
+//   type 0x01 FRAME:  body = 235 raw frame bytes, as received by SPI2
+//   type 0x02 REPEAT: body = count (2), the previous frame was received 'count' more times, last one at tick/seq
+//   check = XOR of every byte after the 0xA5
+#define VFD_RECORD_SYNC			0xA5
+#define VFD_RECORD_FRAME		0x01
+#define VFD_RECORD_REPEAT		0x02
+
+#if VFD_RECORD_ENABLE
+
+// Externally accessible variables
+extern uint32_t vfdRecordFrames;			// FRAME records queued (LIVE WATCH)
+extern uint32_t vfdRecordRepeats;			// REPEAT records queued (LIVE WATCH)
+extern uint32_t vfdRecordDrops;				// Records lost because the UART fell behind (LIVE WATCH)
+
+// Function prototypes
+void VFD_RecordInit(void);
+void VFD_RecordFrame(const uint8_t* frame, uint32_t seq, _Bool changed);
+void DMA1_Channel7_IRQHandler(void);
+
+#endif // VFD_RECORD_ENABLE
+
+#endif // VFDRECORD_H
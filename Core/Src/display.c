@@ -12,6 +12,8 @@
 #include "lcd.h"
 #include "lt7680.h"
 #include "display.h"
+#include "displaylist.h"
+#include "profile.h"
 #include <string.h>  // For strchr, strncpy
 #include <stdio.h>   // For debugging (optional)
 #include <stdbool.h>
@@ -21,7 +23,6 @@
 
 
 #define DURATION_MS 5000     // 5 seconds in milliseconds
-#define TIMER_INTERVAL_MS 35 // The interval of your timed sub in milliseconds
 
 // Display colours default
 uint32_t MainColourFore = 0xFFFF00; // Yellow
@@ -33,6 +34,55 @@ char MaindisplayString[19] = "";              // String for G[1] to G[18]
 _Bool displayBlank = false;
 _Bool displayBlankPrevious = false;
 
+// Shadow copy of what is currently on the LCD, so only cells that have changed get redrawn
+char MainShadow[LINE1_LEN];
+char AuxShadow[LINE2_LEN];
+uint8_t AnnuncShadow[19];
+_Bool MainShadowValid = false;
+_Bool AuxShadowValid = false;
+_Bool AnnuncShadowValid = false;
+
+// Cells redrawn vs. skipped, latched once per frame (LIVE WATCH)
+uint16_t renderCellsRedrawn = 0;
+uint16_t renderCellsSkipped = 0;
+uint32_t renderCellsRedrawnTotal = 0;
+uint32_t renderCellsSkippedTotal = 0;
+static uint16_t renderCellsRedrawnCount = 0;
+static uint16_t renderCellsSkippedCount = 0;
+
+// Glyph atlas, an off-screen image at ATLAS_IMAGE_START holding every character pre-rendered in the MAIN, AUX and
+// annunciator fonts and colours (see DisplayAtlasInit). Sizes are the rotated glyphs as they sit on the canvas.
+#define ATLAS_WIDTH				1024		// Pixels, wide enough for 10 MAIN glyphs side by side
+#define ATLAS_PRINTABLE			95			// 0x20 to 0x7E
+#define ATLAS_GLYPHS			(ATLAS_PRINTABLE + sizeof(atlasExtra))
+#define ATLAS_MAIN_W			96			// 16x32 font X3: 96 pixels in X, 48 in Y
+#define ATLAS_MAIN_H			48
+#define ATLAS_MAIN_PITCH		52			// Y step between MAIN glyphs, the same 4 pixel character spacing as on screen
+#define ATLAS_AUX_W				48			// 12x24 font X2: 48 pixels in X, 24 in Y
+#define ATLAS_AUX_H				24
+#define ATLAS_ANNUNC_W			32			// 8x16 font, height X2: 32 pixels in X, 8 in Y per character
+#define ATLAS_ANNUNC_H			40			// Longest name, 5 characters
+#define ATLAS_ANNUNC_OFF		18			// Annunciator slot left blank (black), copied to turn one off
+#define ATLAS_MAIN_PER_ROW		(ATLAS_WIDTH / ATLAS_MAIN_W)
+#define ATLAS_AUX_PER_ROW		(ATLAS_WIDTH / ATLAS_AUX_W)
+#define ATLAS_MAIN_Y			0
+#define ATLAS_AUX_Y				(ATLAS_MAIN_Y + ((ATLAS_GLYPHS + ATLAS_MAIN_PER_ROW - 1) / ATLAS_MAIN_PER_ROW) * ATLAS_MAIN_PITCH)
+#define ATLAS_ANNUNC_Y			(ATLAS_AUX_Y + ((ATLAS_GLYPHS + ATLAS_AUX_PER_ROW - 1) / ATLAS_AUX_PER_ROW) * ATLAS_AUX_H)
+#define ATLAS_HEIGHT			(ATLAS_ANNUNC_Y + ATLAS_ANNUNC_H)
+
+static const char atlasExtra[] = { '\xB5', '\xB0', '\x1E', '\x1F', '\x1A' };	// UCG symbols outside 0x20-0x7E ('$' is inside)
+_Bool glyphAtlasReady = false;				// Cells are BTE copies from the atlas, false = CGROM text mode (LIVE WATCH)
+
+static const char* AnnuncNames[19] = {
+	"SMPL", "IDLE", "AUTO", "LOP", "NULL", "DFILT", "MATH", "AZERO",
+	"ERR", "INFO", "FRONT", "REAR", "SLOT", "LO_G", "RMT", "TLK",
+	"LTN", "SRQ"
+};
+
+static void DrawMainRow(const char* cells);
+static void DrawAuxRow(const char* cells);
+static int AtlasSlot(char c);
+
 //float test15 = 0;
 //char test16[12];
 
@@ -44,15 +94,12 @@ _Bool displayBlankPrevious = false;
 
 void DisplayMain() {
 
-	// This sub needs re-written in the same way the AUX line is now written - it's on the todo list.
-
-	// MAIN ROW - Print text to LCD, detect if there is an OHM symbol ($) and if so split into 3 parts, before-OHM-after
-	SetTextColors(MainColourFore, 0x000000); // Foreground, Background
+	// MAIN ROW - Build the 18 characters that should be on the LCD, then let DrawMainRow() redraw only the cells that changed.
+	// If there is an OHM symbol ($) it stays in the string and DrawMainRow() draws it as the UCG symbol in its own cell.
 
-	//char MaindisplayString[19] = "";              // String for G[1] to G[18]
-	char BeforeDollar[19] = "";                   // To store characters before the $
-	char AfterDollar[19] = "";                    // To store characters after the $
+	char MainRender[19] = "";                     // What the LCD should show for G[1] to G[18]
 	uint16_t dollarPosition = 0xFFFF;            // Initialize to an invalid position
+	_Bool standardMode = false;
 
 	// Populate MaindisplayString from G[1] to G[18]
 	for (int i = 1; i <= 18; i++) {
@@ -69,85 +116,11 @@ void DisplayMain() {
 	}
 
 	// If in 2W or 4W Resistance measurement mode the display will contain the OHM symbol on the MAIN display.
-	// If it appears then the dollarPositionAUX var will not be 0xFFFF
+	// If it appears then the dollarPosition var will not be 0xFFFF
 	if (dollarPosition != 0xFFFF) {
 
-		// $ symbol found
-		// Before
-		ConfigureFontAndPosition(
-			0b00,    // Internal CGROM
-			0b10,    // Font size
-			0b00,    // ISO 8859-1
-			0,       // Full alignment enabled
-			0,       // Chroma keying disabled
-			1,       // Rotate 90 degrees counterclockwise
-			0b10,    // Width multiplier
-			0b10,    // Height multiplier
-			1,       // Line spacing
-			4,       // Character spacing
-			Xpos_MAIN,      // Cursor X
-			0        // Cursor Y
-		);
-		char MaindisplayStringBefore[19] = "";
-		for (int i = 1; i <= 18; i++) {
-			if (G[i] == '$') break;
-			MaindisplayStringBefore[i - 1] = G[i];
-		}
-		DrawText(MaindisplayStringBefore);
-
-		HAL_Delay(5);
-		ResetGraphicWritePosition_LT();
-		Ohms16x32SymbolStoreUCG();			// This is called here rather than pre-defined because the 2nd UCG below is a different size
-		Text_Mode();
-
-		// Ohm Symbol
-		// Calculate position of $ symbol
-		//       yposohm = (dollarPosition * widthmultiplier * fontwidth) + (characterspacing * dollarPosition) + startoffset(6)
-		uint16_t yposohm = (dollarPosition * 3 * 16) + (4 * dollarPosition);  // Y position of the OHM symbol
-		// The actual OHM
-		ConfigureFontAndPosition(
-			0b10,    // User-Defined Font mode
-			0b10,    // Font size
-			0b00,    // ISO 8859-1
-			0,       // Full alignment enabled
-			0,       // Chroma keying disabled
-			1,       // Rotate 90 degrees counterclockwise
-			0b10,    // Width multiplier
-			0b10,    // Height multiplier
-			1,       // Line spacing
-			4,       // Character spacing
-			Xpos_MAIN,      // Cursor X 170
-			yposohm  // Cursor Y 480	780
-		);
-		// Write the OHM symbol
-		WriteRegister(0x04);
-		WriteData(0x00);    // high byte
-		WriteData(0x00);    // low byte
-
-		HAL_Delay(2);
-
-		// After
-		ConfigureFontAndPosition(
-			0b00,    // Internal CGROM
-			0b10,    // Font size
-			0b00,    // ISO 8859-1
-			0,       // Full alignment enabled
-			0,       // Chroma keying disabled
-			1,       // Rotate 90 degrees counterclockwise
-			0b10,    // Width multiplier
-			0b10,    // Height multiplier
-			1,       // Line spacing
-			4,       // Character spacing
-			Xpos_MAIN,      // Cursor X
-			(dollarPosition * 52) + 52        // Cursor Y	832
-		);
-		char MaindisplayStringAfter[19] = ""; // Adjust the size to match your max expected characters
-		int j = 0; // Index for the new string
-		for (int i = dollarPosition + 1; i <= 18; i++) { // Start after the $ and loop through the rest
-			MaindisplayStringAfter[j++] = MaindisplayString[i]; // Copy characters to the new string
-		}
-		MaindisplayStringAfter[18] = '\0'; // Null-terminate the new string
-		DrawText(MaindisplayStringAfter);
+		// $ symbol found, before-OHM-after are all handled cell by cell
+		memcpy(MainRender, MaindisplayString, sizeof(MainRender));
 
 	} else {
 
@@ -261,28 +234,65 @@ void DisplayMain() {
 			}
 			*/
 
-			ConfigureFontAndPosition(
-				0b00,    // Internal CGROM
-				0b10,    // Font size
-				0b00,    // ISO 8859-1
-				0,       // Full alignment enabled
-				0,       // Chroma keying disabled
-				1,       // Rotate 90 degrees counterclockwise
-				0b10,    // Width multiplier
-				0b10,    // Height multiplier
-				1,       // Line spacing
-				4,       // Character spacing
-				Xpos_MAIN,      // Cursor X
-				0        // Cursor Y
-			);
-			DrawText(MaindisplayString);
+			memcpy(MainRender, MaindisplayString, sizeof(MainRender));
 
 		} else {
 
 			// Standard R6581 display non-OHM mode, including standard 1000mV mode
+			memcpy(MainRender, MaindisplayString, sizeof(MainRender));
+			standardMode = true;
+
+		}
+
+	}
+
+	DrawMainRow(MainRender);
+
+	if (standardMode) {
+		// (strstr(MaindisplayString, "DISPLAY OFF") != NULL))
+		// LCDConfigTurnOn_LT();
+		// LCDConfigTurnOff_LT();
+		CheckDisplayStatus();
+	}
+
+}
+
+
+// Redraw the MAIN cells that differ from MainShadow[]
+// Characters in the glyph atlas are BTE copies, the rest are drawn in text mode
+// Cell i sits at Y = i * 52 (16x32 font X3 = 48 pixels wide + 4 pixels character spacing)
+static void DrawMainRow(const char* cells) {
+
+	_Bool fontConfigured = false;                 // Font & colours only need sending once per row
+	int cursorCell = -1;                          // Cell the LT7680 text cursor is sitting on, -1 if unknown
+	_Bool atlasSelected = false;                  // BTE source & destination only need sending once per row
 
+	for (int i = 0; i < LINE1_LEN; i++) {
+		char c = (cells[i] == '\0') ? ' ' : cells[i];
+
+		if (MainShadowValid && MainShadow[i] == c) {
+			renderCellsSkippedCount++;
+			continue;
+		}
+
+		int slot = glyphAtlasReady ? AtlasSlot(c) : -1;
+		int16_t ucg = LT_UcgCode(c, LT_UCG_16X32);
+		if (slot >= 0) {
+
+			// Pre-rendered glyph, one BTE copy from the atlas
+			if (!atlasSelected) {
+				LT_BteSetup(ATLAS_IMAGE_START, ATLAS_WIDTH, LT_PageDrawn(), LCD_XSIZE_TFT);
+				atlasSelected = true;
+			}
+			LT_BteCopy((slot % ATLAS_MAIN_PER_ROW) * ATLAS_MAIN_W, ATLAS_MAIN_Y + (slot / ATLAS_MAIN_PER_ROW) * ATLAS_MAIN_PITCH,
+				Xpos_MAIN, i * 52, ATLAS_MAIN_W, ATLAS_MAIN_H);
+
+		} else if (ucg >= 0) {
+
+			// Ohm, micro, degree or arrow - user-defined character, uploaded at boot
+			SetTextColors(MainColourFore, 0x000000); // Foreground, Background
 			ConfigureFontAndPosition(
-				0b00,    // Internal CGROM
+				0b10,    // User-Defined Font mode
 				0b10,    // Font size
 				0b00,    // ISO 8859-1
 				0,       // Full alignment enabled
@@ -293,24 +303,48 @@ void DisplayMain() {
 				1,       // Line spacing
 				4,       // Character spacing
 				Xpos_MAIN,      // Cursor X
-				0        // Cursor Y
+				i * 52   // Cursor Y
 			);
-			char MaindisplayString[19] = "";              // String for G[1] to G[18]
-			for (int i = 1; i <= 18; i++) {
-				MaindisplayString[i - 1] = G[i];          // Copy characters
-			}
-			MaindisplayString[18] = '\0';                 // Null-terminate
-			DrawText(MaindisplayString);
+			LT_UcgDraw(ucg);
+
+			fontConfigured = false;             // Font registers now point at the UCG, set CGROM again for the next cell
+			cursorCell = -1;
 
-			// (strstr(MaindisplayString, "DISPLAY OFF") != NULL))
-			// LCDConfigTurnOn_LT();
-			// LCDConfigTurnOff_LT();
-			CheckDisplayStatus();
+		} else {
+
+			if (!fontConfigured) {
+				SetTextColors(MainColourFore, 0x000000); // Foreground, Background
+				ConfigureFontAndPosition(
+					0b00,    // Internal CGROM
+					0b10,    // Font size
+					0b00,    // ISO 8859-1
+					0,       // Full alignment enabled
+					0,       // Chroma keying disabled
+					1,       // Rotate 90 degrees counterclockwise
+					0b10,    // Width multiplier
+					0b10,    // Height multiplier
+					1,       // Line spacing
+					4,       // Character spacing
+					Xpos_MAIN,      // Cursor X
+					i * 52   // Cursor Y
+				);
+				fontConfigured = true;
+			} else if (cursorCell != i) {
+				SetTextCursor(Xpos_MAIN, i * 52);
+			}
+			char cell[2] = { c, '\0' };
+			DrawText(cell);
+			cursorCell = i + 1;                 // The LT7680 advances the cursor by one cell
 
 		}
 
+		LT_PageDirty(Xpos_MAIN, i * 52, ATLAS_MAIN_W, ATLAS_MAIN_PITCH);
+		MainShadow[i] = c;
+		renderCellsRedrawnCount++;
 	}
 
+	MainShadowValid = true;
+
 }
 
 
@@ -348,16 +382,10 @@ void CheckDisplayStatus() {
 
 void DisplayAux() {
 
-	// AUX ROW text to LCD
-
-	SetTextColors(AuxColourFore, 0x000000); // Foreground, Background
+	// AUX ROW - Build the 29 characters that should be on the LCD, then let DrawAuxRow() redraw only the cells that changed.
+	// Any OHM symbols ($) stay in the string and DrawAuxRow() draws them as the UCG symbol in their own cell.
 
 	char AuxdisplayString[30] = "";               // String for G[19] to G[47]
-	uint16_t dollarPositions[5] = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF }; // To store positions of up to 5 $
-	int dollarCount = 0; // Count of $ symbols found
-
-	// Customizable fudge factors for each $ symbol position
-	//int fudgeFactors[5] = { 23, 23, 32, 104 }; // Adjust these values for each $ symbol's position
 
 	// Populate AuxdisplayString from G[19] to G[47]
 	for (int i = 19; i <= 47; i++) {
@@ -365,61 +393,96 @@ void DisplayAux() {
 	}
 	AuxdisplayString[29] = '\0'; // Null-terminate at the 30th position because array starts at 0
 
-	// Find positions of up to 5 $ symbols
-	for (int i = 0; i < 30 && dollarCount < 5; i++) {
-		if (AuxdisplayString[i] == '$') {
-			dollarPositions[dollarCount++] = i; // Store position and increment count
+	// If no $ symbols were found, check for the 1000mV range
+	if (strchr(AuxdisplayString, '$') == NULL) {
+
+		// Detect 1000mV Range
+		//if ((strstr(MaindisplayString, "OVERLOAD") == NULL) &&			// does not contain
+		//	(strpbrk(MaindisplayString, "0123456789") != NULL) &&		// does contain
+		//	(strstr(AuxdisplayString, "1000mV Range") != NULL)) {		// does contain
+		//	onethousandmVmodedetected = true;
+		//} else {
+		//	onethousandmVmodedetected = false;
+		//	oneVoltmode = false;
+		//}
+		if ((strstr(AuxdisplayString, "1000mV Range") != NULL)) {		// does contain
+			onethousandmVmodedetected = true;
+		}
+		else {
+			onethousandmVmodedetected = false;
+			//oneVoltmode = false;
+		}
+
+		// If in 1000mV range and user has enabled the new 1VDC mode
+		if (oneVoltmode && onethousandmVmodedetected) {
+			strcpy(AuxdisplayString, "   1 V Range                 ");
 		}
+
 	}
 
-	uint16_t yposohm = 0; // Initialize y-position for OHM symbol
-	uint16_t yposoffset = 60; // Initialize y-position for OHM symbol
+	DrawAuxRow(AuxdisplayString);
 
-	if (dollarCount != 0) {
+}
 
-		// Process text and OHM symbols based on dollarCount
-		for (int d = 0; d <= dollarCount; d++) {
-			// Calculate start and end positions for text
-			int start = (d == 0) ? 0 : dollarPositions[d - 1] + 1;
-			int end = (d < dollarCount) ? dollarPositions[d] : 30;
 
-			// Print text before or between $ symbols
-			if (start < end) {
-				char AuxdisplaySegment[30] = "";
-				for (int i = start; i < end; i++) {
-					AuxdisplaySegment[i - start] = AuxdisplayString[i];
-				}
-				AuxdisplaySegment[end - start] = '\0'; // Null-terminate
+// Redraw the AUX cells that differ from AuxShadow[]
+// Characters in the glyph atlas are BTE copies, the rest are drawn in text mode
+// Cell i sits at Y = 60 + (i * 12 pixel width character * 2)
+static void DrawAuxRow(const char* cells) {
 
-				ConfigureFontAndPosition(
-					0b00,    // Internal CGROM
-					0b01,    // Font size
-					0b00,    // ISO 8859-1
-					0,       // Full alignment enabled
-					0,       // Chroma keying disabled
-					1,       // Rotate 90 degrees counterclockwise
-					0b01,    // Width multiplier
-					0b01,    // Height multiplier
-					1,       // Line spacing
-					0,       // Character spacing
-					Xpos_AUX,     // Cursor X
-					yposohm = yposoffset + (start * 12 * 2) // Dynamically adjust position, offset + (position * 12 pixel width character * 2)
-				);
-				DrawText(AuxdisplaySegment);
+	_Bool fontConfigured = false;                 // Font & colours only need sending once per row
+	int cursorCell = -1;                          // Cell the LT7680 text cursor is sitting on, -1 if unknown
+	_Bool atlasSelected = false;                  // BTE source & destination only need sending once per row
+
+	for (int i = 0; i < LINE2_LEN; i++) {
+		char c = (cells[i] == '\0') ? ' ' : cells[i];
+
+		if (AuxShadowValid && AuxShadow[i] == c) {
+			renderCellsSkippedCount++;
+			continue;
+		}
+
+		int slot = glyphAtlasReady ? AtlasSlot(c) : -1;
+		int16_t ucg = LT_UcgCode(c, LT_UCG_12X24);
+		if (slot >= 0) {
+
+			// Pre-rendered glyph, one BTE copy from the atlas
+			if (!atlasSelected) {
+				LT_BteSetup(ATLAS_IMAGE_START, ATLAS_WIDTH, LT_PageDrawn(), LCD_XSIZE_TFT);
+				atlasSelected = true;
 			}
+			LT_BteCopy((slot % ATLAS_AUX_PER_ROW) * ATLAS_AUX_W, ATLAS_AUX_Y + (slot / ATLAS_AUX_PER_ROW) * ATLAS_AUX_H,
+				Xpos_AUX, 60 + (i * 24), ATLAS_AUX_W, ATLAS_AUX_H);
 
-			HAL_Delay(5);
-			ResetGraphicWritePosition_LT();
-			Ohms12x24SymbolStoreUCG(); // This is called here rather than pre-defined because the 1st UCG above is a different size
-			Text_Mode();
+		} else if (ucg >= 0) {
 
-			// Print OHM symbol if within dollarCount
-			if (d < dollarCount) {
-				uint16_t calculated_value = (dollarPositions[d] * 12 * 2);		// 12 pixel width character * 2
-				yposohm = yposoffset + (uint16_t)calculated_value;
+			// Ohm, micro, degree or arrow - user-defined character, uploaded at boot
+			SetTextColors(AuxColourFore, 0x000000); // Foreground, Background
+			ConfigureFontAndPosition(
+				0b10,    // User-Defined Font mode
+				0b01,    // Font size
+				0b00,    // ISO 8859-1
+				0,       // Full alignment enabled
+				0,       // Chroma keying disabled
+				1,       // Rotate 90 degrees counterclockwise
+				0b01,    // Width multiplier
+				0b01,    // Height multiplier
+				1,       // Line spacing
+				0,       // Character spacing
+				Xpos_AUX,     // Cursor X
+				60 + (i * 24) // Cursor Y
+			);
+			LT_UcgDraw(ucg);
+
+			fontConfigured = false;             // Font registers now point at the UCG, set CGROM again for the next cell
+			cursorCell = -1;
 
+		} else {
+
+			if (!fontConfigured) {
+				SetTextColors(AuxColourFore, 0x000000); // Foreground, Background
 				ConfigureFontAndPosition(
-					0b10,    // User-Defined Font mode
+					0b00,    // Internal CGROM
 					0b01,    // Font size
 					0b00,    // ISO 8859-1
 					0,       // Full alignment enabled
@@ -430,69 +493,25 @@ void DisplayAux() {
 					1,       // Line spacing
 					0,       // Character spacing
 					Xpos_AUX,     // Cursor X
-					yposohm  // Cursor Y
+					60 + (i * 24) // Cursor Y
 				);
-				WriteRegister(0x04);
-				WriteData(0x00);    // high byte
-				WriteData(0x00);    // low byte
+				fontConfigured = true;
+			} else if (cursorCell != i) {
+				SetTextCursor(Xpos_AUX, 60 + (i * 24));
 			}
-		}
-
-	}
-
-	// If no $ symbols were found, print the entire string as-is	
-
-	if (dollarCount == 0) {
+			char cell[2] = { c, '\0' };
+			DrawText(cell);
+			cursorCell = i + 1;                 // The LT7680 advances the cursor by one cell
 
-		// Detect 1000mV Range
-		//if ((strstr(MaindisplayString, "OVERLOAD") == NULL) &&			// does not contain
-		//	(strpbrk(MaindisplayString, "0123456789") != NULL) &&		// does contain
-		//	(strstr(AuxdisplayString, "1000mV Range") != NULL)) {		// does contain
-		//	onethousandmVmodedetected = true;
-		//} else {
-		//	onethousandmVmodedetected = false;
-		//	oneVoltmode = false;
-		//}
-		if ((strstr(AuxdisplayString, "1000mV Range") != NULL)) {		// does contain
-			onethousandmVmodedetected = true;
-		}
-		else {
-			onethousandmVmodedetected = false;
-			//oneVoltmode = false;
-		}
-
-		// If in 1000mV range and user has enabled the new 1VDC mode
-		if (oneVoltmode && onethousandmVmodedetected) {
-			yposohm = 60;
-		}
-		else {
-			yposohm = 60;
 		}
 
-		ConfigureFontAndPosition(
-			0b00,    // Internal CGROM
-			0b01,    // Font size
-			0b00,    // ISO 8859-1
-			0,       // Full alignment enabled
-			0,       // Chroma keying disabled
-			1,       // Rotate 90 degrees counterclockwise
-			0b01,    // Width multiplier
-			0b01,    // Height multiplier
-			5,       // Line spacing
-			0,       // Character spacing
-			Xpos_AUX,     // Cursor X
-			yposohm       // Cursor Y
-		);
+		LT_PageDirty(Xpos_AUX, 60 + (i * 24), ATLAS_AUX_W, ATLAS_AUX_H);
+		AuxShadow[i] = c;
+		renderCellsRedrawnCount++;
+	}
 
-		// If in 1000mV range and user has enabled the new 1VDC mode
-		if (oneVoltmode && onethousandmVmodedetected) {
-			DrawText("   1 V Range                 ");
-		}
-		else {
-			DrawText(AuxdisplayString);
-		}
+	AuxShadowValid = true;
 
-	}
 }
 
 
@@ -500,13 +519,7 @@ void DisplayAux() {
 
 void DisplayAnnunciators() {
 
-	// ANNUNCIATORS - Print or clear text on the LCD
-	const char* AnnuncNames[19] = {
-		"SMPL", "IDLE", "AUTO", "LOP", "NULL", "DFILT", "MATH", "AZERO",
-		"ERR", "INFO", "FRONT", "REAR", "SLOT", "LO_G", "RMT", "TLK",
-		"LTN", "SRQ"
-	};
-
+	// ANNUNCIATORS - Print or clear text on the LCD, only for those that have changed state since the last frame
 
 	// Set Y-position of the annunciators
 	int AnnuncYCoords[19] = {
@@ -531,27 +544,30 @@ void DisplayAnnunciators() {
 	};
 
 
+	_Bool atlasSelected = false;                  // BTE source & destination only need sending once
+
 	for (int i = 0; i < 18; i++) {
-		if (Annunc[i + 1] == 1) {  // Turn the annunciator ON
-			SetTextColors(AnnunColourFore, 0x000000); // Foreground: Green, Background: Black
-			ConfigureFontAndPosition(
-				0b00,    // Internal CGROM
-				0b00,    // 16-dot font size
-				0b00,    // ISO 8859-1
-				0,       // Full alignment enabled
-				0,       // Chroma keying disabled
-				1,       // Rotate 90 degrees counterclockwise
-				0b00,    // Width X0
-				0b01,    // Height X0
-				5,       // Line spacing
-				0,       // Character spacing
-				Xpos_ANNUNC,  // Cursor X (fixed)
-				AnnuncYCoords[i] // Cursor Y (from array)
-			);
-			DrawText(AnnuncNames[i]); // Print the corresponding name
+		if (AnnuncShadowValid && AnnuncShadow[i + 1] == Annunc[i + 1]) {
+			renderCellsSkippedCount++;
+			continue;
 		}
-		else {  // Turn the annunciator OFF
-			SetTextColors(0x000000, 0x000000); // Foreground: Black, Background: Black
+
+		if (glyphAtlasReady) {
+			// Copy the name, or the blank slot to clear it, from the atlas
+			int slot = (Annunc[i + 1] == 1) ? i : ATLAS_ANNUNC_OFF;
+			if (!atlasSelected) {
+				LT_BteSetup(ATLAS_IMAGE_START, ATLAS_WIDTH, LT_PageDrawn(), LCD_XSIZE_TFT);
+				atlasSelected = true;
+			}
+			LT_BteCopy(slot * ATLAS_ANNUNC_W, ATLAS_ANNUNC_Y, Xpos_ANNUNC, AnnuncYCoords[i], ATLAS_ANNUNC_W, strlen(AnnuncNames[i]) * 8);
+		}
+		else {
+			if (Annunc[i + 1] == 1) {  // Turn the annunciator ON
+				SetTextColors(AnnunColourFore, 0x000000); // Foreground: Green, Background: Black
+			}
+			else {  // Turn the annunciator OFF
+				SetTextColors(0x000000, 0x000000); // Foreground: Black, Background: Black
+			}
 			ConfigureFontAndPosition(
 				0b00,    // Internal CGROM
 				0b00,    // 16-dot font size
@@ -566,10 +582,132 @@ void DisplayAnnunciators() {
 				Xpos_ANNUNC,  // Cursor X (fixed)
 				AnnuncYCoords[i] // Cursor Y (from array)
 			);
-			DrawText(AnnuncNames[i]); // Clear the text by drawing in black
+			DrawText(AnnuncNames[i]); // Print the corresponding name, or clear the text by drawing in black
 		}
+
+		LT_PageDirty(Xpos_ANNUNC, AnnuncYCoords[i], ATLAS_ANNUNC_W, ATLAS_ANNUNC_H);
+		AnnuncShadow[i + 1] = Annunc[i + 1];
+		renderCellsRedrawnCount++;
 	}
 
+	AnnuncShadowValid = true;
+
+	// Annunciators are the last thing drawn each frame, latch the per-frame counters for LIVE WATCH
+	renderCellsRedrawn = renderCellsRedrawnCount;
+	renderCellsSkipped = renderCellsSkippedCount;
+	renderCellsRedrawnTotal += renderCellsRedrawnCount;
+	renderCellsSkippedTotal += renderCellsSkippedCount;
+	renderCellsRedrawnCount = 0;
+	renderCellsSkippedCount = 0;
+
+}
+
+
+// Force the next DisplayMain(), DisplayAux() & DisplayAnnunciators() to redraw every cell, i.e. after the screen has been cleared
+void DisplayInvalidate() {
+
+	MainShadowValid = false;
+	AuxShadowValid = false;
+	AnnuncShadowValid = false;
+
+}
+
+
+//******************************************************************************
+
+// Glyph atlas slot of character c, or -1 if it isn't in the atlas
+static int AtlasSlot(char c) {
+
+	if (c >= 0x20 && c <= 0x7E) return c - 0x20;
+
+	for (int i = 0; i < (int)sizeof(atlasExtra); i++) {
+		if (atlasExtra[i] == c) return ATLAS_PRINTABLE + i;
+	}
+	return -1;
+
+}
+
+
+// Draw character c at (x, y) in the MAIN (LT_UCG_16X32) or AUX (LT_UCG_12X24) font, exactly as the text mode
+// path of DrawMainRow() / DrawAuxRow() does
+static void AtlasDrawChar(char c, uint8_t size, uint16_t x, uint16_t y) {
+
+	int16_t ucg = LT_UcgCode(c, size);
+	uint8_t scale = (size == LT_UCG_16X32) ? 0b10 : 0b01;
+
+	ConfigureFontAndPosition(
+		(ucg >= 0) ? 0b10 : 0b00,    // User-Defined Font mode or Internal CGROM
+		(size == LT_UCG_16X32) ? 0b10 : 0b01,    // Font size
+		0b00,    // ISO 8859-1
+		0,       // Full alignment enabled
+		0,       // Chroma keying disabled
+		1,       // Rotate 90 degrees counterclockwise
+		scale,   // Width multiplier
+		scale,   // Height multiplier
+		1,       // Line spacing
+		(size == LT_UCG_16X32) ? 4 : 0,    // Character spacing
+		x,       // Cursor X
+		y        // Cursor Y
+	);
+
+	if (ucg >= 0) {
+		LT_UcgDraw(ucg);
+	} else {
+		char cell[2] = { c, '\0' };
+		DrawText(cell);
+	}
+
+}
+
+
+// Pre-render the glyph atlas, once at boot after the colours have been read and the LT7680 has been set up.
+// The canvas is pointed at the atlas image, every printable character plus the UCG symbols is drawn in the MAIN
+// and AUX fonts and colours, then each annunciator name in its ON colour, and the canvas is put back.
+// From then on a changed cell is a single BTE memory copy, a dozen register writes whatever the font size,
+// instead of font setup plus a text write, and the atlas could hold glyphs the CGROM doesn't have.
+void DisplayAtlasInit() {
+
+	LT_SetCanvas(ATLAS_IMAGE_START, ATLAS_WIDTH, ATLAS_HEIGHT);
+
+	SetTextColors(MainColourFore, 0x000000);
+	for (int slot = 0; slot < (int)ATLAS_GLYPHS; slot++) {
+		char c = (slot < ATLAS_PRINTABLE) ? (char)(0x20 + slot) : atlasExtra[slot - ATLAS_PRINTABLE];
+		AtlasDrawChar(c, LT_UCG_16X32, (slot % ATLAS_MAIN_PER_ROW) * ATLAS_MAIN_W, ATLAS_MAIN_Y + (slot / ATLAS_MAIN_PER_ROW) * ATLAS_MAIN_PITCH);
+	}
+
+	SetTextColors(AuxColourFore, 0x000000);
+	for (int slot = 0; slot < (int)ATLAS_GLYPHS; slot++) {
+		char c = (slot < ATLAS_PRINTABLE) ? (char)(0x20 + slot) : atlasExtra[slot - ATLAS_PRINTABLE];
+		AtlasDrawChar(c, LT_UCG_12X24, (slot % ATLAS_AUX_PER_ROW) * ATLAS_AUX_W, ATLAS_AUX_Y + (slot / ATLAS_AUX_PER_ROW) * ATLAS_AUX_H);
+	}
+
+	for (int i = 0; i <= ATLAS_ANNUNC_OFF; i++) {
+		if (i < ATLAS_ANNUNC_OFF) {
+			SetTextColors(AnnunColourFore, 0x000000);
+		} else {
+			SetTextColors(0x000000, 0x000000);    // The OFF slot, black spaces
+		}
+		ConfigureFontAndPosition(
+			0b00,    // Internal CGROM
+			0b00,    // 16-dot font size
+			0b00,    // ISO 8859-1
+			0,       // Full alignment enabled
+			0,       // Chroma keying disabled
+			1,       // Rotate 90 degrees counterclockwise
+			0b00,    // Width X0
+			0b01,    // Height X0
+			5,       // Line spacing
+			0,       // Character spacing
+			i * ATLAS_ANNUNC_W,  // Cursor X
+			ATLAS_ANNUNC_Y       // Cursor Y
+		);
+		DrawText((i < ATLAS_ANNUNC_OFF) ? AnnuncNames[i] : "     ");
+	}
+
+	LT_WaitIdle();
+	LT_SetCanvas(MAIN_IMAGE_START, LCD_XSIZE_TFT, LCD_YSIZE_TFT);
+	glyphAtlasReady = true;
+
 }
 
 //******************************************************************************
@@ -577,12 +715,12 @@ void DisplayAnnunciators() {
 void DisplaySplash() {
 
 	// Splash text to display
-	static uint32_t cycle_count = 0; // Persistent counter for cycles
+	static uint32_t start_tick = 0;  // Time of the first call, renders are no longer at a fixed interval
 	static uint8_t timer_active = 1; // Flag to track timer status
 	if (timer_active) {
-		cycle_count++;
+		if (start_tick == 0) start_tick = HAL_GetTick();
 		// Check if the 5-second period has elapsed
-		if (cycle_count >= (DURATION_MS / TIMER_INTERVAL_MS)) {
+		if (HAL_GetTick() - start_tick >= DURATION_MS) {
 			// Runs once
 			timer_active = 0; // Stop counting after 5 seconds
 			SetTextColors(0x00FF00, 0x000000); // Foreground: Yellow, Background: Black
@@ -602,6 +740,7 @@ void DisplaySplash() {
 			);
 			char text[] = "                                                           ";
 			DrawText(text);
+			LT_PageDirty(Xpos_SPLASH, 100, 16, strlen(text) * 12);	// 8 pixel characters + 4 spacing
 
 			SetTextColors(0xFF0000, 0x000000); // Foreground: Yellow, Background: Black
 			ConfigureFontAndPosition(
@@ -620,6 +759,25 @@ void DisplaySplash() {
 			);
 			char text2[] = "                        ";
 			DrawText(text2);
+			LT_PageDirty(130, 640, 16, strlen(text2) * 12);	// 8 pixel characters + 4 spacing
+
+			ConfigureFontAndPosition(
+				0b00,    // Internal CGROM
+				0b00,    // Font size
+				0b00,    // ISO 8859-1
+				0,       // Full alignment enabled
+				0,       // Chroma keying disabled
+				1,       // Rotate 90 degrees counterclockwise
+				0b00,    // Width multiplier
+				0b00,    // Height multiplier
+				1,       // Line spacing
+				4,       // Character spacing
+				110,     // Cursor X
+				100      // Cursor Y
+			);
+			char text3[] = "                                                               ";	// Clears the longest textboot[]
+			DrawText(text3);
+			LT_PageDirty(110, 100, 16, strlen(text3) * 12);	// 8 pixel characters + 4 spacing
 
 		}
 		else {
@@ -642,6 +800,7 @@ void DisplaySplash() {
 			);
 			char text[] = "Reverse engineering by By MickleT / TFT LCD by Ian Johnston";
 			DrawText(text);
+			LT_PageDirty(Xpos_SPLASH, 100, 16, strlen(text) * 12);	// 8 pixel characters + 4 spacing
 
 			SetTextColors(0x909090, 0x000000); // Foreground: grey, Background: Black
 			ConfigureFontAndPosition(
@@ -671,6 +830,38 @@ void DisplaySplash() {
 				ADA_BUY
 			);
 			DrawText(textsettings);
+			LT_PageDirty(130, 640, 16, strlen(textsettings) * 12);	// 8 pixel characters + 4 spacing
+
+			// Boot timeline in ms, phases as in BootPhaseId, below the timing values
+			ConfigureFontAndPosition(
+				0b00,    // Internal CGROM
+				0b00,    // Font size
+				0b00,    // ISO 8859-1
+				0,       // Full alignment enabled
+				0,       // Chroma keying disabled
+				1,       // Rotate 90 degrees counterclockwise
+				0b00,    // Width multiplier
+				0b00,    // Height multiplier
+				1,       // Line spacing
+				4,       // Character spacing
+				110,     // Cursor X
+				100      // Cursor Y
+			);
+			char textboot[64];
+			snprintf(textboot, sizeof(textboot),
+				"Boot %lu HAL %lu CLK %lu PER %lu RST %lu LT %lu CLR %lu EEP %lu LCD %lu",
+				(unsigned long)(bootLog.at[BOOT_LCD_INIT] / 1000),
+				(unsigned long)(bootLog.us[BOOT_HAL_INIT] / 1000),
+				(unsigned long)(bootLog.us[BOOT_CLOCK] / 1000),
+				(unsigned long)(bootLog.us[BOOT_PERIPHERALS] / 1000),
+				(unsigned long)(bootLog.us[BOOT_LT_RESET] / 1000),
+				(unsigned long)(bootLog.us[BOOT_LT_SETUP] / 1000),
+				(unsigned long)(bootLog.us[BOOT_CLEAR] / 1000),
+				(unsigned long)(bootLog.us[BOOT_EEPROM] / 1000),
+				(unsigned long)(bootLog.us[BOOT_LCD_INIT] / 1000)
+			);
+			DrawText(textboot);
+			LT_PageDirty(110, 100, 16, strlen(textboot) * 12);	// 8 pixel characters + 4 spacing
 		}
 	}
 
@@ -0,0 +1,398 @@
+/**
+  ******************************************************************************
+  * @file    displaylist.c
+  * @brief   This file provides code for the LT7680 display list,
+  *          recorded in RAM and streamed to the LT7680 by SPI1 TX DMA.
+  ******************************************************************************
+*/
+
+// Every LT7680 write is a 2-byte SPI frame (control byte + register/data byte) in its own CS cycle.
+// Between LT_DisplayListBegin() and LT_DisplayListEnd() the core commands in lt7680.c append their frames to a
+// display list instead of sending them. LT_DisplayListEnd() hands the list to DMA1 Channel 3 and returns straight
+// away, so the main loop can decode the next VFD frame while the SPI bus drains.
+//
+// The DMA sends one frame at a time: Channel 3 transmits it and Channel 2 receives the two bytes clocked back.
+// The Channel 2 transfer-complete interrupt fires once the last bit is in, raises CS and starts the next frame.
+//
+// Status polls (DL_OP_WAIT_REG, DL_OP_WAIT_REG_SET, DL_OP_WAIT_STATUS) are read frames sent the same way, the reply
+// lands in dlRx[]. The interrupt never waits for the LT7680: if the condition is not met yet, TIM3 is armed and its
+// interrupt sends the next read frame LT_POLL_INTERVAL_US later (LT_VSYNC_POLL_US for the VSYNC wait). Delays
+// (DL_OP_DELAY) pause the list and SysTick picks it up again. Either way the CPU carries on decoding in between.
+//
+// Status polls give up after LT_WAIT_TIMEOUT_US (DWT cycle counter timebase) and count the timeout, so a missing
+// or wedged LT7680 can't stall the list or the main loop.
+//
+// Two lists are used, one being recorded while the other is sent. SPI1_TX_completed_flag is the fence: a new
+// list is not started until the previous one has completed, and any blocking LT7680 access waits on it first.
+
+#include "displaylist.h"
+#include "lt7680.h"
+#include "main.h"
+
+// Display list engine state
+#define DL_IDLE					0
+#define DL_RUN					1
+#define DL_PAUSED				2			// DL_OP_DELAY, resumed from SysTick
+#define DL_POLL_WAIT			3			// Poll condition not met yet, resumed from TIM3
+
+// What the frame in flight is
+#define DL_XFER_WRITE			0
+#define DL_XFER_READ			1			// Poll read, the reply is dlRx[1]
+
+static uint8_t dlBuf[2][DL_ENTRIES * 3];	// Entries are 3 bytes: opcode, a, b
+static uint16_t dlLen[2] = { 0, 0 };		// Entries recorded in each list
+static uint8_t dlFill = 0;					// List being recorded
+
+static const uint8_t* volatile dlTx;		// List being sent
+static volatile uint16_t dlTxPos = 0;		// Byte position in dlTx
+static volatile uint16_t dlTxLen = 0;		// Length of dlTx in bytes
+static volatile uint8_t dlState = DL_IDLE;
+static volatile uint32_t dlResumeTick = 0;
+
+static uint8_t dlRx[2];						// Bytes received with the frame in flight
+static uint8_t dlXfer = DL_XFER_WRITE;
+static uint8_t dlPollStep = 0;				// 0 = poll op not started, 1 = register selected / polling
+static uint32_t dlPollStart;				// DWT cycle count when the poll op started
+static uint8_t dlSelect[2] = { 0x00, 0x00 };	// Command write, register to poll
+static const uint8_t dlReadStatus[2] = { 0x40, 0x00 };	// Status read
+static const uint8_t dlReadData[2] = { 0xC0, 0x00 };	// Data read
+
+_Bool displayListRecording = false;
+uint16_t displayListEntriesPeak = 0;		// Largest list recorded (LIVE WATCH)
+uint32_t displayListOverflows = 0;			// Lists sent early because they filled up (LIVE WATCH)
+uint32_t displayListWaitsMerged = 0;		// Status waits dropped as already covered by the one before (LIVE WATCH)
+volatile uint32_t ltWaitTimeouts = 0;		// Status polls that gave up, every poll loop counts here (LIVE WATCH)
+
+
+// Microsecond timebase for the status poll timeouts, from the DWT cycle counter started by Profile_Init()
+static uint32_t DL_TimeoutCycles(void) {
+	return (SystemCoreClock / 1000000) * LT_WAIT_TIMEOUT_US;
+}
+
+
+// True once LT_WAIT_TIMEOUT_US has passed since 'start' (a DWT->CYCCNT), counted in ltWaitTimeouts
+_Bool LT_WaitTimedOut(uint32_t start) {
+	if (DWT->CYCCNT - start < DL_TimeoutCycles()) return false;
+	ltWaitTimeouts++;
+	return true;
+}
+
+
+//******************************************************************************
+// Engine, runs in the DMA1 Channel 2 / Channel 3 and TIM3 interrupts (all priority 1, so never nested)
+
+// Send one 2-byte frame, Channel 2 interrupts once both bytes have been clocked out and back in
+static void DL_StartFrame(const uint8_t* frame, uint8_t xfer) {
+	dlXfer = xfer;
+	SPI_CS_PORT->BSRR = (uint32_t)SPI_CS_PIN << 16;	// CS Low
+	DMA1_Channel2->CMAR = (uint32_t)dlRx;
+	DMA1_Channel2->CNDTR = 2;
+	DMA1_Channel2->CCR |= DMA_CCR_EN;			// RX first, so nothing is missed
+	DMA1_Channel3->CMAR = (uint32_t)frame;
+	DMA1_Channel3->CNDTR = 2;
+	DMA1_Channel3->CCR |= DMA_CCR_EN;
+#if LT_HOST_SIM
+	dlRx[1] = LtSim_Frame(frame[0], frame[1]);	// The register model answers at once, the sim raises the transfer complete
+#endif
+	LT_COUNT_FRAME(2);
+}
+
+
+// Next poll read in 'us', from TIM3 (one pulse, 1 us ticks)
+static void DL_PollLater(uint16_t us) {
+	dlState = DL_POLL_WAIT;
+	TIM3->ARR = us - 1;
+	TIM3->CNT = 0;
+	TIM3->CR1 |= TIM_CR1_CEN;
+}
+
+
+// Poll op at dlTxPos: has the reply in dlRx[1] met its condition?
+static _Bool DL_PollDone(const uint8_t* e) {
+	uint8_t value = dlRx[1];
+
+	switch (e[0]) {
+	case DL_OP_WAIT_REG:		return (value & e[2]) == 0;
+	case DL_OP_WAIT_REG_SET:	return (value & e[2]) != 0;
+	case DL_OP_WAIT_STATUS:		return (value & e[1]) == e[2];
+	default:					return true;
+	}
+}
+
+
+// Work through the list until a frame has been handed to the DMA, the list pauses, or the list ends
+static void DL_Run(void) {
+	while (dlTxPos < dlTxLen) {
+		const uint8_t* e = &dlTx[dlTxPos];
+
+		switch (e[0]) {
+		case DL_OP_FRAME:
+			dlTxPos += 3;
+			DL_StartFrame(&e[1], DL_XFER_WRITE);
+			return;
+
+		case DL_OP_WAIT_REG:
+		case DL_OP_WAIT_REG_SET:
+			if (dlPollStep == 0) {					// Select the register once, then only read it
+				dlPollStep = 1;
+				dlPollStart = DWT->CYCCNT;
+				dlSelect[1] = e[1];
+				DL_StartFrame(dlSelect, DL_XFER_WRITE);
+				return;
+			}
+			DL_StartFrame(dlReadData, DL_XFER_READ);
+			return;
+
+		case DL_OP_WAIT_STATUS:
+			if (dlPollStep == 0) {
+				dlPollStep = 1;
+				dlPollStart = DWT->CYCCNT;
+			}
+			DL_StartFrame(dlReadStatus, DL_XFER_READ);
+			return;
+
+		case DL_OP_DELAY:
+			dlTxPos += 3;
+			dlResumeTick = HAL_GetTick() + e[1] + 1;	// +1 the same as HAL_Delay(), so at least e[1] ms
+			dlState = DL_PAUSED;
+			return;
+
+		default:
+			dlTxPos += 3;
+			break;
+		}
+	}
+
+	// List complete
+	SPI1->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+	dlState = DL_IDLE;
+	SPI1_TX_completed_flag = 1;
+}
+
+
+// Called from DMA1_Channel2_IRQHandler and DMA1_Channel3_IRQHandler
+void LT_DisplayListIRQHandler(void) {
+	if (DMA1->ISR & DMA_ISR_TCIF2) {
+		// RX complete: both bytes have been clocked, the frame is over
+		DMA1->IFCR = DMA_IFCR_CGIF2 | DMA_IFCR_CGIF3;
+		DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+		DMA1_Channel3->CCR &= ~DMA_CCR_EN;
+		SPI_CS_PORT->BSRR = SPI_CS_PIN;			// CS High
+
+		if (dlXfer == DL_XFER_READ) {
+			const uint8_t* e = &dlTx[dlTxPos];
+			if (DL_PollDone(e) || LT_WaitTimedOut(dlPollStart)) {
+				dlTxPos += 3;
+				dlPollStep = 0;
+			}
+			else {
+				DL_PollLater((e[0] == DL_OP_WAIT_REG_SET) ? LT_VSYNC_POLL_US : LT_POLL_INTERVAL_US);
+				return;
+			}
+		}
+	}
+
+	// Also entered via NVIC_SetPendingIRQ() to start a list or resume one after a delay or poll interval
+	if (dlState == DL_RUN && !(DMA1_Channel2->CCR & DMA_CCR_EN)) {
+		DL_Run();
+	}
+}
+
+
+// TIM3 one pulse has run out, send the next poll read
+void TIM3_IRQHandler(void) {
+	if (TIM3->SR & TIM_SR_UIF) {
+		TIM3->SR = ~TIM_SR_UIF;
+		if (dlState == DL_POLL_WAIT) {
+			dlState = DL_RUN;
+			NVIC_SetPendingIRQ(DMA1_Channel3_IRQn);
+		}
+	}
+}
+
+
+// Called from SysTick_Handler, resumes a paused list once its delay has elapsed
+void LT_DisplayListTick(void) {
+	if (dlState == DL_PAUSED && (int32_t)(HAL_GetTick() - dlResumeTick) >= 0) {
+		dlState = DL_RUN;
+		NVIC_SetPendingIRQ(DMA1_Channel3_IRQn);
+	}
+}
+
+
+// TIM3 as the poll interval timer: 1 us ticks, one pulse, update interrupt at the display list priority
+void LT_DisplayListInit(void) {
+	RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+	(void)RCC->APB1ENR;						// Delay after enabling the clock
+
+	TIM3->CR1 = TIM_CR1_OPM | TIM_CR1_URS;	// Stop after one pulse, only overflow raises UIF
+	TIM3->PSC = (SystemCoreClock / 1000000) - 1;	// Timer clock is 72 MHz, as for TIM2
+	TIM3->EGR = TIM_EGR_UG;					// Load the prescaler
+	TIM3->SR = 0;
+	TIM3->DIER = TIM_DIER_UIE;
+
+	HAL_NVIC_SetPriority(TIM3_IRQn, 1, 0);	// Same as the DMA, so the engine is never re-entered
+	HAL_NVIC_EnableIRQ(TIM3_IRQn);
+}
+
+
+//******************************************************************************
+// Recording and submitting
+
+// Start sending list 'idx'. Waits for the previous list first (the fence).
+static void DL_Submit(uint8_t idx) {
+	LT_DisplayListWait();
+
+	if (dlLen[idx] == 0) return;
+
+	dlTx = dlBuf[idx];
+	dlTxLen = dlLen[idx] * 3;
+	dlTxPos = 0;
+	dlPollStep = 0;
+
+	// DMA1 Channel 3: memory to SPI1->DR, byte wide, memory increment
+	// DMA1 Channel 2: SPI1->DR to dlRx[], byte wide, memory increment, transfer-complete interrupt ends each frame
+	DMA1_Channel3->CCR = DMA_CCR_DIR | DMA_CCR_MINC;
+	DMA1_Channel3->CPAR = (uint32_t)&SPI1->DR;
+	DMA1_Channel2->CCR = DMA_CCR_MINC | DMA_CCR_TCIE;
+	DMA1_Channel2->CPAR = (uint32_t)&SPI1->DR;
+
+	(void)SPI1->DR;								// Drop stale RX data & overrun left by blocking write frames
+	(void)SPI1->SR;
+	SPI1->CR1 |= SPI_CR1_SPE;
+	SPI1->CR2 |= SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+
+	SPI1_TX_completed_flag = 0;
+	dlState = DL_RUN;
+	NVIC_SetPendingIRQ(DMA1_Channel3_IRQn);		// First frame is started from the interrupt like all the others
+}
+
+
+// Send the list being recorded and carry on recording into the other one
+static void DL_SubmitAndSwap(void) {
+	DL_Submit(dlFill);
+	dlFill ^= 1;
+	dlLen[dlFill] = 0;							// Free, DL_Submit() waited for it to complete
+}
+
+
+static void DL_Add(uint8_t op, uint8_t a, uint8_t b) {
+	if (dlLen[dlFill] >= DL_ENTRIES) {
+		displayListOverflows++;
+		DL_SubmitAndSwap();
+	}
+
+	uint8_t* e = &dlBuf[dlFill][dlLen[dlFill] * 3];
+	e[0] = op;
+	e[1] = a;
+	e[2] = b;
+	dlLen[dlFill]++;
+
+	if (dlLen[dlFill] > displayListEntriesPeak) displayListEntriesPeak = dlLen[dlFill];
+}
+
+
+// Start recording LT7680 writes into a display list
+void LT_DisplayListBegin(void) {
+	dlLen[dlFill] = 0;
+	displayListRecording = true;
+}
+
+
+// Stop recording and send the list in the background. Returns without waiting for it.
+void LT_DisplayListEnd(void) {
+	displayListRecording = false;
+	DL_SubmitAndSwap();
+}
+
+
+// Wait for the list in flight to complete
+void LT_DisplayListWait(void) {
+	while (!SPI1_TX_completed_flag) {}
+}
+
+
+// Send everything recorded so far and wait for it, i.e. before a read. Recording carries on afterwards.
+void LT_DisplayListFlush(void) {
+	if (displayListRecording) {
+		DL_SubmitAndSwap();
+	}
+	LT_DisplayListWait();
+}
+
+
+void LT_DisplayListFrame(uint8_t control, uint8_t data) {
+	DL_Add(DL_OP_FRAME, control, data);
+}
+
+
+void LT_DisplayListWaitReg(uint8_t reg, uint8_t mask) {
+	DL_Add(DL_OP_WAIT_REG, reg, mask);
+}
+
+
+// A wait straight after one that already covers it is dropped, nothing has been sent in between for it to wait
+// on. E.g. DrawText()'s first FIFO-empty wait after LT_WaitIdle().
+void LT_DisplayListWaitStatus(uint8_t mask, uint8_t value) {
+	if (dlLen[dlFill] > 0) {
+		const uint8_t* last = &dlBuf[dlFill][(dlLen[dlFill] - 1) * 3];
+		if (last[0] == DL_OP_WAIT_STATUS && (last[1] & mask) == mask && (last[2] & mask) == value) {
+			displayListWaitsMerged++;
+			return;
+		}
+	}
+	DL_Add(DL_OP_WAIT_STATUS, mask, value);
+}
+
+
+void LT_DisplayListWaitRegSet(uint8_t reg, uint8_t mask) {
+	DL_Add(DL_OP_WAIT_REG_SET, reg, mask);
+}
+
+
+// Delay that keeps its place in the LT7680 command stream
+// Recording: a pause in the display list, the CPU carries on. Otherwise the same as HAL_Delay().
+void LT_Delay(uint32_t ms) {
+	if (!displayListRecording) {
+		LT_DisplayListWait();
+		HAL_Delay(ms);
+		return;
+	}
+
+	while (ms > 0) {
+		uint8_t chunk = (ms > 255) ? 255 : (uint8_t)ms;
+		DL_Add(DL_OP_DELAY, chunk, 0);
+		ms -= chunk;
+	}
+}
+
+
+// Wait until the LT7680 has caught up: write FIFO empty and core (text, line and BTE engines) not busy.
+// Replaces fixed delays, each stage carries on as soon as the controller is ready.
+// Recording: a status poll in the display list. Otherwise polls STSR here, both with a timeout.
+void LT_WaitIdle(void) {
+	if (displayListRecording) {
+		LT_DisplayListWaitStatus(STSR_WFIFO_EMPTY | STSR_CORE_BUSY, STSR_WFIFO_EMPTY);
+		return;
+	}
+
+	uint32_t start = DWT->CYCCNT;
+	while (((ReadStatus() & (STSR_WFIFO_EMPTY | STSR_CORE_BUSY)) != STSR_WFIFO_EMPTY) && !LT_WaitTimedOut(start)) {}
+}
+
+
+// Wait for the start of the next vertical blank: clear the LT7680 VSYNC flag, then wait for it to be set again.
+// Recording: the list holds for up to a panel frame, polling every LT_VSYNC_POLL_US, the CPU is not held.
+void LT_WaitVsync(void) {
+	WriteDataToRegister(0x0C, LT_INT_VSYNC);	// INTF, write 1 to clear
+
+	if (displayListRecording) {
+		LT_DisplayListWaitRegSet(0x0C, LT_INT_VSYNC);
+		return;
+	}
+
+	uint32_t start = DWT->CYCCNT;
+	do {
+		WriteRegister(0x0C);
+	} while (!(ReadData() & LT_INT_VSYNC) && !LT_WaitTimedOut(start));
+}
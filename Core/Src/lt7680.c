@@ -29,6 +29,7 @@
 */
 
 #include "lt7680.h"
+#include "displaylist.h"
 #include "main.h"
 #include <string.h>
 #include <stdio.h>
@@ -42,12 +43,58 @@ volatile uint8_t system_ok = 0;
 volatile uint8_t LT7680_SPI_Read_ok = 0;
 volatile uint8_t System_Check = 0;
 volatile uint8_t SystemCheckTempValue = 0;
+uint8_t textFifoBurst = 1;              // Characters per DrawText() burst, learned at boot by LT_TextFifoLearnDepth()
+uint32_t textFifoFullPolls = 0;         // Status reads that found the FIFO full (LIVE WATCH)
+volatile uint32_t ltSpiBytes = 0;       // SPI1 bytes exchanged with the LT7680, blocking and display list (LIVE WATCH)
+volatile uint32_t ltSpiTransactions = 0;    // CS cycles, i.e. SPI frames (LIVE WATCH)
+uint32_t ltSpiPrescaler = LT_SPI_PRESCALER_SAFE;    // SPI1 BR bits in use, set by LT_SpiAutoTune() (LIVE WATCH)
+uint32_t ltSpiLinkErrors = 0;           // Round trips that read back wrong while tuning (LIVE WATCH)
+#if LT_SPI_BENCH_ENABLE
+LtSpiBench ltSpiBench;
+#endif
+
+// BTE S0 X/Y, destination X/Y and size registers (0x99-0x9C, 0xAD-0xB4) as last written by LT_BteCopy(), so a
+// copy only sends the bytes that changed. Forgotten on a software reset, which puts the registers back to default.
+static uint8_t bteRegs[12];
+static _Bool bteRegsValid = false;
+static _Bool bteIdle = false;           // Nothing written since the last copy finished, no wait before the next
+
+// Bring-up waits: poll the LT7680 until it reports ready, giving up after 'ms'. Returns false on a timeout
+// (counted in ltWaitTimeouts) and bring-up carries on regardless, no later than the old fixed delays would have.
+static _Bool LT_BootTimedOut(uint32_t start, uint32_t ms) {
+    if (DWT->CYCCNT - start < (SystemCoreClock / 1000) * ms) return false;
+    ltWaitTimeouts++;
+    return true;
+}
+
+// STSR until (status & mask) == value. A status of 0xFF is MISO floating, the LT7680 is not answering yet.
+static _Bool LT_BootWaitStatus(uint8_t mask, uint8_t value, uint32_t ms) {
+    uint32_t start = DWT->CYCCNT;
+    uint8_t status;
+
+    do {
+        status = ReadStatus();
+        if (status != 0xFF && (status & mask) == value) return true;
+    } while (!LT_BootTimedOut(start, ms));
+    return false;
+}
+
+// Register until (value & mask) != 0
+static _Bool LT_BootWaitReg(uint8_t reg, uint8_t mask, uint32_t ms) {
+    uint32_t start = DWT->CYCCNT;
+
+    do {
+        WriteRegister(reg);
+        if (ReadData() & mask) return true;
+    } while (!LT_BootTimedOut(start, ms));
+    return false;
+}
 
 void HardwareReset(void) {
     HAL_GPIO_WritePin(RESET_PORT, RESET_PIN, GPIO_PIN_RESET); // Pull reset low
-    HAL_Delay(100); // Delay 100 ms
+    HAL_Delay(LT_RESET_PULSE_MS);
     HAL_GPIO_WritePin(RESET_PORT, RESET_PIN, GPIO_PIN_SET);   // Release reset
-    HAL_Delay(100); // Delay 100 ms
+    LT_BootWaitStatus(STSR_INHIBIT, 0, LT_RESET_READY_MS);    // Ready once the power-on initialisation is done
 }
 
 
@@ -57,52 +104,93 @@ void HardwareReset(void) {
 //**************************************************************************************************
 // Core commands
 
+// Register level SPI1 for the blocking transfers. A frame is the control byte and one more byte in one CS cycle.
+// The second byte is written as soon as TXE shows the control byte has moved to the shift register, so the two
+// go out back to back, and for a read the byte clocked in during that second byte is the reply.
+
+// Write frame, what comes back is not needed. The overrun it leaves is cleared at the start of the next read.
+static inline void LT_SpiWriteFrame(uint8_t control, uint8_t data) {
+#if LT_HOST_SIM
+    (void)LtSim_Frame(control, data);
+#else
+    SPI_CS_PORT->BSRR = (uint32_t)SPI_CS_PIN << 16;            // CS Low
+    *(__IO uint8_t*)&SPI1->DR = control;
+    while (!(SPI1->SR & SPI_SR_TXE)) {}
+    *(__IO uint8_t*)&SPI1->DR = data;
+    while (!(SPI1->SR & SPI_SR_TXE)) {}
+    while (SPI1->SR & SPI_SR_BSY) {}
+    SPI_CS_PORT->BSRR = SPI_CS_PIN;                             // CS High
+#endif
+    LT_COUNT_FRAME(2);
+}
+
+// Read frame, returns the reply. Interrupts are held off for the few cycles between the two RXNEs, an interrupt
+// there would overrun the receiver and lose the reply.
+static inline uint8_t LT_SpiReadFrame(uint8_t control) {
+    uint8_t reply;
+#if LT_HOST_SIM
+    reply = LtSim_Frame(control, 0x00);
+#else
+    uint32_t primask = __get_PRIMASK();
+
+    (void)SPI1->DR;                                             // Drop stale RX data & overrun from write frames
+    (void)SPI1->SR;
+
+    __disable_irq();
+    SPI_CS_PORT->BSRR = (uint32_t)SPI_CS_PIN << 16;            // CS Low
+    *(__IO uint8_t*)&SPI1->DR = control;
+    while (!(SPI1->SR & SPI_SR_TXE)) {}
+    *(__IO uint8_t*)&SPI1->DR = 0x00;                           // Clocks the reply in
+    while (!(SPI1->SR & SPI_SR_RXNE)) {}
+    (void)*(__IO uint8_t*)&SPI1->DR;                            // Received during the control byte
+    __set_PRIMASK(primask);
+    while (!(SPI1->SR & SPI_SR_RXNE)) {}
+    reply = *(__IO uint8_t*)&SPI1->DR;
+    while (SPI1->SR & SPI_SR_BSY) {}
+    SPI_CS_PORT->BSRR = SPI_CS_PIN;                             // CS High
+#endif
+    LT_COUNT_FRAME(2);
+
+    return reply;
+}
+
 // Write Register Address
+// Control byte and register address go out as one 2-byte transfer within a single CS frame
 void WriteRegister(uint8_t reg) {
-    uint8_t controlByte = 0x00; // A0 = 0, RW = 0
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
-    HAL_SPI_Transmit(&hspi1, &controlByte, 1, HAL_MAX_DELAY);                 // Send control byte
-    HAL_SPI_Transmit(&hspi1, &reg, 1, HAL_MAX_DELAY);                         // Send register address
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
+    if (displayListRecording) {
+        LT_DisplayListFrame(0x00, reg);     // Sent later by the display list DMA
+        bteIdle = false;
+        return;
+    }
+    LT_DisplayListWait();                   // Never share the bus with a display list still being sent
+    LT_SpiWriteFrame(0x00, reg);            // A0 = 0, RW = 0
+    bteIdle = false;
 }
 
 // Write Data
 void WriteData(uint8_t data) {
-    uint8_t controlByte = 0x80; // A0 = 1, RW = 0
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
-    HAL_SPI_Transmit(&hspi1, &controlByte, 1, HAL_MAX_DELAY);                 // Send control byte
-    HAL_SPI_Transmit(&hspi1, &data, 1, HAL_MAX_DELAY);                        // Send data byte
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
+    if (displayListRecording) {
+        LT_DisplayListFrame(0x80, data);    // Sent later by the display list DMA
+        bteIdle = false;
+        return;
+    }
+    LT_DisplayListWait();                   // Never share the bus with a display list still being sent
+    LT_SpiWriteFrame(0x80, data);           // A0 = 1, RW = 0
+    bteIdle = false;
 }
 
 // Read Status Register
 uint8_t ReadStatus(void) {
-    uint8_t controlByte = 0x40; // A0 = 0, RW = 1
-    uint8_t status = 0x00;      // Variable to hold the status byte
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
-
-    // Attempt SPI transmit and receive
-    if (HAL_SPI_Transmit(&hspi1, &controlByte, 1, HAL_MAX_DELAY) == HAL_OK &&
-        HAL_SPI_Receive(&hspi1, &status, 1, HAL_MAX_DELAY) == HAL_OK) {
-        LT7680_SPI_Read_ok = 1; // SPI read was successful
-    }
-    else {
-        LT7680_SPI_Read_ok = 0; // SPI read failed
-    }
-
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
+    LT_DisplayListFlush();      // Anything recorded must reach the LT7680 before it is read back
+    uint8_t status = LT_SpiReadFrame(0x40);    // A0 = 0, RW = 1
+    LT7680_SPI_Read_ok = 1;     // Register level, the read always completes
     return status;
 }
 
 // Read Data from Register
 uint8_t ReadData(void) {
-    uint8_t controlByte = 0xC0; // A0 = 1, RW = 1
-    uint8_t data = 0x00; // Variable to hold the data byte
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
-    HAL_SPI_Transmit(&hspi1, &controlByte, 1, HAL_MAX_DELAY);                 // Send control byte
-    HAL_SPI_Receive(&hspi1, &data, 1, HAL_MAX_DELAY);                         // Read data byte
-    HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
-    return data;
+    LT_DisplayListFlush();      // Anything recorded must reach the LT7680 before it is read back
+    return LT_SpiReadFrame(0xC0);   // A0 = 1, RW = 1
 }
 
 // Write Register Address and Data (combined) - optional
@@ -112,67 +200,211 @@ void WriteDataToRegister(uint8_t reg, uint8_t value) {
 }
 
 
+//**************************************************************************************************
+// Command lists
+// (register, value) pairs are packed into one buffer as ready-to-send SPI frames and then sent in one go:
+//   [0x00, reg] [0x80, value] [0x00, reg] [0x80, value] ...
+// The LT7680 latches a command/data byte on CS rising, so each frame still needs its own CS cycle,
+// but each frame is a single 2-byte HAL transfer and there is no per-write function call overhead.
+// Usage: LT_CmdListBegin(); LT_CmdListAdd(reg, value); ... LT_CmdListSend();
+
+static uint8_t cmdList[LT_CMDLIST_MAX_PAIRS * 4];
+static uint16_t cmdListLen = 0;
+
+void LT_CmdListBegin(void) {
+    cmdListLen = 0;
+}
+
+void LT_CmdListAdd(uint8_t reg, uint8_t value) {
+    if (cmdListLen >= sizeof(cmdList)) {
+        LT_CmdListSend();                   // List full, send what we have and carry on
+    }
+    cmdList[cmdListLen++] = 0x00;           // Command write
+    cmdList[cmdListLen++] = reg;
+    cmdList[cmdListLen++] = 0x80;           // Data write
+    cmdList[cmdListLen++] = value;
+}
+
+void LT_CmdListSend(void) {
+    if (displayListRecording) {
+        for (uint16_t i = 0; i < cmdListLen; i += 2) {
+            LT_DisplayListFrame(cmdList[i], cmdList[i + 1]);
+        }
+        if (cmdListLen) bteIdle = false;
+        cmdListLen = 0;
+        return;
+    }
+    LT_DisplayListWait();
+    for (uint16_t i = 0; i < cmdListLen; i += 2) {
+        LT_SpiWriteFrame(cmdList[i], cmdList[i + 1]);
+    }
+    if (cmdListLen) bteIdle = false;
+    cmdListLen = 0;
+}
+
+
+//**************************************************************************************************
+// SPI1 clock auto-tune
+
+// Change the SPI1 clock. SPE must be off while the BR bits change, and nothing may be on the bus.
+static void LT_SpiSetPrescaler(uint32_t prescaler) {
+    LT_DisplayListWait();
+    while (hspi1.Instance->SR & SPI_SR_BSY) {}
+    __HAL_SPI_DISABLE(&hspi1);
+    hspi1.Init.BaudRatePrescaler = prescaler;
+    hspi1.Instance->CR1 = (hspi1.Instance->CR1 & ~SPI_CR1_BR) | prescaler;
+    __HAL_SPI_ENABLE(&hspi1);
+    ltSpiPrescaler = prescaler;
+}
+
+
+// Write test patterns to the scratch register and read each one back, at the current SPI1 clock.
+// Returns true if all 'trips' round trips came back intact. The register is restored afterwards.
+_Bool LT_SpiLinkTest(uint16_t trips) {
+    static const uint8_t patterns[8] = { 0x55, 0xAA, 0x00, 0xFF, 0x0F, 0xF0, 0x5A, 0xA5 };
+    _Bool ok = true;
+
+    WriteRegister(LT_SPI_SCRATCH_REG);
+    uint8_t saved = ReadData();
+
+    for (uint16_t i = 0; i < trips; i++) {
+        uint8_t pattern = patterns[i % 8] ^ (uint8_t)(i / 8);   // Walks through the other values too
+        WriteDataToRegister(LT_SPI_SCRATCH_REG, pattern);
+        WriteRegister(LT_SPI_SCRATCH_REG);
+        if (ReadData() != pattern) {
+            ltSpiLinkErrors++;
+            ok = false;
+        }
+    }
+
+    WriteDataToRegister(LT_SPI_SCRATCH_REG, saved);
+    return ok;
+}
+
+
+// Pick the SPI1 clock for the LT7680, returns the prescaler (SPI_BAUDRATEPRESCALER_x) now in use.
+// A 'stored' prescaler from the settings page is re-verified and kept if it still passes. Otherwise each faster
+// clock is tried in turn from LT_SPI_PRESCALER_SAFE, and the one a step slower than the fastest to pass is kept
+// (margin). If even the safe clock fails, it is used anyway, as it always was.
+// A write at a clock that fails can land in any register (reset, PLL, SDRAM, MISA), so after a failed round trip
+// the LT7680 is reset and set up again by SendAllToLT7680_LT() at the safe clock, before the new one is set.
+uint32_t LT_SpiAutoTune(uint32_t stored) {
+    uint32_t errors = ltSpiLinkErrors;
+
+    if ((stored & ~SPI_CR1_BR) == 0 && stored <= LT_SPI_PRESCALER_SAFE) {
+        LT_SpiSetPrescaler(stored);
+        if (LT_SpiLinkTest(LT_SPI_ROUND_TRIPS)) return stored;
+    }
+
+    uint32_t fastest = LT_SPI_PRESCALER_SAFE;
+    for (uint32_t prescaler = LT_SPI_PRESCALER_SAFE; ; prescaler -= SPI_CR1_BR_0) {  // Each step halves it
+        LT_SpiSetPrescaler(prescaler);
+        if (!LT_SpiLinkTest(LT_SPI_ROUND_TRIPS)) break;
+        fastest = prescaler;
+        if (prescaler == SPI_BAUDRATEPRESCALER_2) break;
+    }
+
+    if (ltSpiLinkErrors != errors) {
+        LT_SpiSetPrescaler(LT_SPI_PRESCALER_SAFE);
+        HardwareReset();
+        SendAllToLT7680_LT();
+    }
+
+    uint32_t keep = (fastest < LT_SPI_PRESCALER_SAFE) ? fastest + SPI_CR1_BR_0 : LT_SPI_PRESCALER_SAFE;
+    LT_SpiSetPrescaler(keep);
+    return keep;
+}
+
+
+#if LT_SPI_BENCH_ENABLE
+// Time LT_SPI_BENCH_FRAMES frames each way with the HAL and with the register level transfers. The write frames
+// only select the scratch register and the reads are status reads, so nothing on the LT7680 changes.
+void LT_SpiBenchmark(void) {
+    uint8_t frame[2] = { 0x00, LT_SPI_SCRATCH_REG };
+    uint8_t control = 0x40;
+    uint8_t status;
+    uint32_t t;
+
+    LT_DisplayListWait();
+    ltSpiBench.prescaler = ltSpiPrescaler;
+
+    t = DWT->CYCCNT;
+    for (int i = 0; i < LT_SPI_BENCH_FRAMES; i++) {
+        HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
+        HAL_SPI_Transmit(&hspi1, frame, 2, HAL_MAX_DELAY);
+        HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
+    }
+    ltSpiBench.halWrite = (DWT->CYCCNT - t) / LT_SPI_BENCH_FRAMES;
+
+    t = DWT->CYCCNT;
+    for (int i = 0; i < LT_SPI_BENCH_FRAMES; i++) {
+        HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_RESET); // CS Low
+        HAL_SPI_Transmit(&hspi1, &control, 1, HAL_MAX_DELAY);
+        HAL_SPI_Receive(&hspi1, &status, 1, HAL_MAX_DELAY);
+        HAL_GPIO_WritePin(SPI_CS_PORT, SPI_CS_PIN, GPIO_PIN_SET);   // CS High
+    }
+    ltSpiBench.halRead = (DWT->CYCCNT - t) / LT_SPI_BENCH_FRAMES;
+    ltSpiBytes += LT_SPI_BENCH_FRAMES * 2 * 2;     // Count the HAL frames too
+    ltSpiTransactions += LT_SPI_BENCH_FRAMES * 2;
+
+    t = DWT->CYCCNT;
+    for (int i = 0; i < LT_SPI_BENCH_FRAMES; i++) {
+        WriteRegister(LT_SPI_SCRATCH_REG);
+    }
+    ltSpiBench.regWrite = (DWT->CYCCNT - t) / LT_SPI_BENCH_FRAMES;
+
+    t = DWT->CYCCNT;
+    for (int i = 0; i < LT_SPI_BENCH_FRAMES; i++) {
+        (void)ReadStatus();
+    }
+    ltSpiBench.regRead = (DWT->CYCCNT - t) / LT_SPI_BENCH_FRAMES;
+}
+#endif // LT_SPI_BENCH_ENABLE
+
+
 //**************************************************************************************************
 // Subs to run and sent to the LT7680
 
 void SendAllToLT7680_LT() {
   
+    // Only the reset, the PLL and the SDRAM take time, each is polled until the LT7680 reports it ready.
+    // Everything else is register writes, sent back to back.
     Software_Reset_LT();
-    HAL_Delay(10);
+    LT_BootWaitStatus(STSR_INHIBIT, 0, LT_RESET_READY_MS);
     LT7680_PLL_Initial_LT();                  // Initialize PLL first for stable clocks
-    HAL_Delay(100);
     SDRAM_Init_LT();                          // Initialize SDRAM after the reset
-    HAL_Delay(5);
 
     Set_LCD_Panel_LT();                       // Set up the panel interface
-    HAL_Delay(100);
 
     //WriteRegister(0x84);                      // Set backlighting Prescaler to zero which effectively turns off backlighting
     //WriteData(0x00); // Prescaler = 00
-    //HAL_Delay(5);
 
     LCDConfigTurnOn_LT();
-    HAL_Delay(5);
 
     LCD_HorizontalWidth_VerticalHeight_LT(LCD_XSIZE_TFT, LCD_YSIZE_TFT);
-    HAL_Delay(5);
     LCD_Horizontal_Non_Display_LT(LCD_HBPD);  // Horizontal Back Porch
-    HAL_Delay(5);
     LCD_HSYNC_Start_Position_LT(LCD_HFPD);    // HSYNC Start Position
-    HAL_Delay(5);
     LCD_HSYNC_Pulse_Width_LT(LCD_HSPW);       // HSYNC Pulse Width
-    HAL_Delay(5);
     LCD_Vertical_Non_Display_LT(LCD_VBPD);    // Vertical Back Porch
-    HAL_Delay(5);
     LCD_VSYNC_Start_Position_LT(LCD_VFPD);    // VSYNC Start Position
-    HAL_Delay(5);
     LCD_VSYNC_Pulse_Width_LT(LCD_VSPW);       // VSYNC Pulse Width
-    HAL_Delay(5);
     SetColorDepth_LT();                       // Configure canvas color depth
-    HAL_Delay(5);
     Configure_Main_PIP_Window_LT();
-    HAL_Delay(5);
     SetMainImageWidth_LT();
-    HAL_Delay(5);
     SetMainWindowUpperLeftX_LT();
-    HAL_Delay(5);
     ConfigureActiveDisplayArea_LT();
-    HAL_Delay(5);
     SetActiveWindow_LT();                     // Set active window dimensions
-    HAL_Delay(5);
     SetCanvasStartAddress_LT();
-    HAL_Delay(5);
     SetCanvasImageWidth_LT();
-    HAL_Delay(5);
     ResetGraphicWritePosition_LT();
-    HAL_Delay(5);
     SetGraphicRWYCoordinate_LT();
-    HAL_Delay(5);
     Set_MISA_LT();                            // Configure the Main Image Start Address
-    HAL_Delay(5);
+    LT_WaitIdle();
    
     Text_Mode();
-    ClearScreen();                          // Draws black 'spaces' across the whole screen - fast
+    LT_TextFifoLearnDepth();                // How many characters DrawText() can send per burst
+    ClearScreen();                          // One black filled rectangle over the whole canvas
+    LT_UcgInit();                           // Upload the Ohm, micro, degree and arrow symbols once
     
 }
 
@@ -252,43 +484,33 @@ void DrawLine(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, ui
     //WriteData(0x01); // Set bit 0 to start drawing
 
     // Set the starting point X-coordinate
-    WriteRegister(0x68); // DLHSR[7:0]
-    WriteData(startX & 0xFF);
-    WriteRegister(0x69); // DLHSR[12:8]
-    WriteData((startX >> 8) & 0x1F);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x68, startX & 0xFF); // DLHSR[7:0]
+    LT_CmdListAdd(0x69, (startX >> 8) & 0x1F); // DLHSR[12:8]
 
     // Set the starting point Y-coordinate
-    WriteRegister(0x6A); // DLVSR[7:0]
-    WriteData(startY & 0xFF);
-    WriteRegister(0x6B); // DLVSR[12:8]
-    WriteData((startY >> 8) & 0x1F);
+    LT_CmdListAdd(0x6A, startY & 0xFF); // DLVSR[7:0]
+    LT_CmdListAdd(0x6B, (startY >> 8) & 0x1F); // DLVSR[12:8]
 
     // Set the ending point X-coordinate
-    WriteRegister(0x6C); // DLHER[7:0]
-    WriteData(endX & 0xFF);
-    WriteRegister(0x6D); // DLHER[12:8]
-    WriteData((endX >> 8) & 0x1F);
+    LT_CmdListAdd(0x6C, endX & 0xFF); // DLHER[7:0]
+    LT_CmdListAdd(0x6D, (endX >> 8) & 0x1F); // DLHER[12:8]
 
     // Set the ending point Y-coordinate
-    WriteRegister(0x6E); // DLVER[7:0]
-    WriteData(endY & 0xFF);
-    WriteRegister(0x6F); // DLVER[12:8]
-    WriteData((endY >> 8) & 0x1F);
+    LT_CmdListAdd(0x6E, endY & 0xFF); // DLVER[7:0]
+    LT_CmdListAdd(0x6F, (endY >> 8) & 0x1F); // DLVER[12:8]
 
     // Set line width
     //WriteRegister(0x63); // Line Width Register (Assumed for line width)
     //WriteData(lineWidth);
 
     // Set line color (Foreground Color Register)
-    WriteRegister(0xD2); // Foreground Color Low Byte
-    WriteData(colorRED);
-    WriteRegister(0xD3); // Foreground Color Low Byte
-    WriteData(colorGREEN);
-    WriteRegister(0xD4); // Foreground Color Low Byte
-    WriteData(colorBLUE);
+    LT_CmdListAdd(0xD2, colorRED); // Foreground Color Low Byte
+    LT_CmdListAdd(0xD3, colorGREEN); // Foreground Color Low Byte
+    LT_CmdListAdd(0xD4, colorBLUE); // Foreground Color Low Byte
 
-    WriteRegister(0x67); // Draw Line/Triangle Control Register
-    WriteData(0x80 | 0x00); // Start drawing (bit 7 = 1) and select "Draw Line" (bits 4-1 = 0000)
+    LT_CmdListAdd(0x67, 0x80 | 0x00); // Start drawing (bit 7 = 1) and select "Draw Line" (bits 4-1 = 0000)
+    LT_CmdListSend();
 
     // Optionally, wait for the drawing to complete (polling)
     //uint8_t drawlineFinished;
@@ -299,117 +521,721 @@ void DrawLine(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, ui
 }
 
 
+// Rectangle on the geometric drawing engine, corners (startX, startY) and (endX, endY) inclusive, in RGB colour.
+// REG[76h] DCR1 selects the shape and starts it: bit 7 start, bit 6 fill, bits 5-4 = 10b rectangle.
+// One command whatever the size, the engine draws it while the MCU carries on. LT_WaitIdle() waits for it.
+static void DrawRectangle(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE, uint8_t fill) {
 
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x68, startX & 0xFF);         // DLHSR[7:0]
+    LT_CmdListAdd(0x69, (startX >> 8) & 0x1F);  // DLHSR[12:8]
+    LT_CmdListAdd(0x6A, startY & 0xFF);         // DLVSR[7:0]
+    LT_CmdListAdd(0x6B, (startY >> 8) & 0x1F);  // DLVSR[12:8]
+    LT_CmdListAdd(0x6C, endX & 0xFF);           // DLHER[7:0]
+    LT_CmdListAdd(0x6D, (endX >> 8) & 0x1F);    // DLHER[12:8]
+    LT_CmdListAdd(0x6E, endY & 0xFF);           // DLVER[7:0]
+    LT_CmdListAdd(0x6F, (endY >> 8) & 0x1F);    // DLVER[12:8]
 
+    LT_CmdListAdd(0xD2, colorRED);              // Foreground colour
+    LT_CmdListAdd(0xD3, colorGREEN);
+    LT_CmdListAdd(0xD4, colorBLUE);
+
+    LT_CmdListAdd(0x76, 0x80 | (fill ? 0x40 : 0x00) | 0x20);   // Start, fill, rectangle
+    LT_CmdListSend();
+}
+
+
+// Filled rectangle
+void FillRect(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE) {
+    DrawRectangle(startX, startY, endX, endY, colorRED, colorGREEN, colorBLUE, 1);
+}
+
+
+// Rectangle outline, 1 pixel
+void DrawRect(uint16_t startX, uint16_t startY, uint16_t endX, uint16_t endY, uint16_t colorRED, uint16_t colorGREEN, uint16_t colorBLUE) {
+    DrawRectangle(startX, startY, endX, endY, colorRED, colorGREEN, colorBLUE, 0);
+}
+
+
+// Point the canvas (where text and graphics land) at another image in SDRAM, 'width' pixels wide, with the
+// active window covering width x height from its top left.
+// LT_SetCanvas(MAIN_IMAGE_START, LCD_XSIZE_TFT, LCD_YSIZE_TFT) puts it back on the displayed image.
+void LT_SetCanvas(uint32_t address, uint16_t width, uint16_t height) {
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x50, address & 0xFF);            // CVSSA[7:0], bit[1:0] = 0
+    LT_CmdListAdd(0x51, (address >> 8) & 0xFF);     // CVSSA[15:8]
+    LT_CmdListAdd(0x52, (address >> 16) & 0xFF);    // CVSSA[23:16]
+    LT_CmdListAdd(0x53, (address >> 24) & 0xFF);    // CVSSA[31:24]
+    LT_CmdListAdd(0x54, width & 0xFF);              // CVS_IMWTH[7:0]
+    LT_CmdListAdd(0x55, (width >> 8) & 0x3F);       // CVS_IMWTH[13:8]
+
+    LT_CmdListAdd(0x56, 0x00);                      // Active window X start
+    LT_CmdListAdd(0x57, 0x00);
+    LT_CmdListAdd(0x58, 0x00);                      // Active window Y start
+    LT_CmdListAdd(0x59, 0x00);
+    LT_CmdListAdd(0x5A, width & 0xFF);              // Active window width
+    LT_CmdListAdd(0x5B, (width >> 8) & 0x1F);
+    LT_CmdListAdd(0x5C, height & 0xFF);             // Active window height
+    LT_CmdListAdd(0x5D, (height >> 8) & 0x1F);
+    LT_CmdListSend();
+}
+
+
+//**************************************************************************************************
+// Block Transfer Engine (BTE) memory copy
+// LT_BteSetup() selects the source (S0) and destination images, both 16bpp, and LT_BteCopy() then copies one
+// rectangle from the source to the destination. The source and destination stay set until the next
+// LT_BteSetup(), so each copy only needs its coordinates, size and the start.
+
+void LT_BteSetup(uint32_t srcAddress, uint16_t srcWidth, uint32_t dstAddress, uint16_t dstWidth) {
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x91, 0xC2);                      // BLT_CTRL1: ROP 1100b (destination = S0), memory copy with ROP
+    LT_CmdListAdd(0x92, 0x25);                      // BLT_COLR: S0, S1 and destination all 16bpp
+
+    LT_CmdListAdd(0x93, srcAddress & 0xFF);         // S0 start address
+    LT_CmdListAdd(0x94, (srcAddress >> 8) & 0xFF);
+    LT_CmdListAdd(0x95, (srcAddress >> 16) & 0xFF);
+    LT_CmdListAdd(0x96, (srcAddress >> 24) & 0xFF);
+    LT_CmdListAdd(0x97, srcWidth & 0xFF);           // S0 image width
+    LT_CmdListAdd(0x98, (srcWidth >> 8) & 0x1F);
+
+    LT_CmdListAdd(0xA7, dstAddress & 0xFF);         // Destination start address
+    LT_CmdListAdd(0xA8, (dstAddress >> 8) & 0xFF);
+    LT_CmdListAdd(0xA9, (dstAddress >> 16) & 0xFF);
+    LT_CmdListAdd(0xAA, (dstAddress >> 24) & 0xFF);
+    LT_CmdListAdd(0xAB, dstWidth & 0xFF);           // Destination image width
+    LT_CmdListAdd(0xAC, (dstWidth >> 8) & 0x1F);
+    LT_CmdListSend();
+}
+
+
+// Queue one BTE coordinate/size register byte, skipped when it already holds that value
+static void LT_BteReg(uint8_t index, uint8_t reg, uint8_t value) {
+    if (bteRegsValid && bteRegs[index] == value) return;
+    bteRegs[index] = value;
+    LT_CmdListAdd(reg, value);
+}
+
+// Copy width x height pixels from (srcX, srcY) in the source image to (dstX, dstY) in the destination image
+// Only the registers that differ from the last copy are written: a row of cells usually moves S0 X and
+// destination X alone, the size stays put.
+void LT_BteCopy(uint16_t srcX, uint16_t srcY, uint16_t dstX, uint16_t dstY, uint16_t width, uint16_t height) {
+    _Bool idle = bteIdle;                           // Read before the register writes below clear it
+
+    LT_CmdListBegin();
+    LT_BteReg(0, 0x99, srcX & 0xFF);                // S0 X
+    LT_BteReg(1, 0x9A, (srcX >> 8) & 0x1F);
+    LT_BteReg(2, 0x9B, srcY & 0xFF);                // S0 Y
+    LT_BteReg(3, 0x9C, (srcY >> 8) & 0x1F);
+    LT_BteReg(4, 0xAD, dstX & 0xFF);                // Destination X
+    LT_BteReg(5, 0xAE, (dstX >> 8) & 0x1F);
+    LT_BteReg(6, 0xAF, dstY & 0xFF);                // Destination Y
+    LT_BteReg(7, 0xB0, (dstY >> 8) & 0x1F);
+    LT_BteReg(8, 0xB1, width & 0xFF);               // BTE width
+    LT_BteReg(9, 0xB2, (width >> 8) & 0x1F);
+    LT_BteReg(10, 0xB3, height & 0xFF);             // BTE height
+    LT_BteReg(11, 0xB4, (height >> 8) & 0x1F);
+    LT_CmdListSend();
+    bteRegsValid = true;
+
+    if (!idle) LT_WaitIdle();                       // Text still being drawn must finish first, a previous copy already has
+    WriteDataToRegister(0x90, 0x10);                // BLT_CTRL0: start the BTE
+    LT_WaitIdle();                                  // Done before anything else is written to SDRAM
+    bteIdle = true;
+}
+
+
+//**************************************************************************************************
+// Double buffering
+// Two canvases in SDRAM: the one the panel shows (MISA) and the one being drawn (canvas start). A render pass
+// draws into the hidden page and records what it touched with LT_PageDirty(). LT_PageFlip(), at the end of the
+// pass, waits for the next vertical blank and points MISA at the page just drawn, so a multi-step update (an
+// annunciator cleared then redrawn, the cells either side of an Ohm) is never seen half done.
+// The page that was showing is then one pass behind, so the dirty rectangles are BTE copied across to it and
+// both pages are identical again before the next pass draws into it.
+// Dirty rectangles with the same X and width (a row of cells) are merged into one, so a pass is a few copies.
+
+typedef struct {
+    uint16_t x, y, w, h;
+} PageRect;
+
+static PageRect pageDirty[LT_PAGE_DIRTY_MAX];
+static uint8_t pageDirtyCount = 0;
+static _Bool pageDirtyAll = false;              // Too many rectangles, sync the whole page
+static _Bool pageEnabled = false;               // false = single buffered, everything is drawn on MISA
+static uint32_t pageShown = MAIN_IMAGE_START;
+static uint32_t pageDrawn = MAIN_IMAGE_START;
+uint32_t ltPageFlips = 0;                       // (LIVE WATCH)
+
+
+static void LT_SetMISA(uint32_t address) {
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x20, address & 0xFF);            // MISA[7:0], bit[1:0] = 0
+    LT_CmdListAdd(0x21, (address >> 8) & 0xFF);     // MISA[15:8]
+    LT_CmdListAdd(0x22, (address >> 16) & 0xFF);    // MISA[23:16]
+    LT_CmdListAdd(0x23, (address >> 24) & 0xFF);    // MISA[31:24]
+    LT_CmdListSend();
+}
 
-// UGC symbol - 16x32
-void Ohms16x32SymbolStoreUCG() {
-    // CGRAM_START_ADDR 0x1000  // Base address for CGRAM
-    // UGC_CODE 0x0000 // UGC code for 16/32 & 12x24 OHM symbols
-    // CGRAM ADDR + (UGC_CODE * 64);  // Calculate UCG address for 16x32
-
-    // 16x32 UCG data for the Ohm symbol
-    // written to 1000h
-    uint8_t ohm[64] = {
-        0x00, 0x00,  // Row 1:  0000000000000000        // UCG code = 0000h
-        0x00, 0x00,  // Row 2:  0000000000000000
-        0x00, 0x00,  // Row 3:  0000000000000000
-        0x00, 0x00,  // Row 4:  0000000000000000
-        0x00, 0x00,  // Row 5:  0000000000000000
-        0x00, 0x00,  // Row 6:  0000000000000000
-        0x0F, 0xF0,  // Row 7:  0000111111110000
-        0x1F, 0xF8,  // Row 8:  0001111111111000
-        0x30, 0x0C,  // Row 9:  0011000000001100
-        0x60, 0x06,  // Row 10: 0110000000000110
-        0x60, 0x06,  // Row 11: 0110000000000110
-        0x60, 0x06,  // Row 12: 0110000000000110
-        0x60, 0x06,  // Row 13: 0110000000000110
-        0x60, 0x06,  // Row 14: 0110000000000110
-        0x60, 0x06,  // Row 15: 0110000000000110
-        0x60, 0x06,  // Row 16: 0110000000000110
-        0x60, 0x06,  // Row 17: 0110000000000110
-        0x60, 0x06,  // Row 18: 0110000000000110
-        0x60, 0x06,  // Row 19: 0110000000000110
-        0x30, 0x0C,  // Row 20: 0011000000001100
-        0x18, 0x18,  // Row 21: 0001100000011000
-        0x0C, 0x30,  // Row 22: 0000110000110000
-        0x0C, 0x30,  // Row 23: 0000110000110000
-        0x0C, 0x30,  // Row 24: 0000110000110000
-        0x7C, 0x3E,  // Row 25: 0111110000111110
-        0x7C, 0x3E,  // Row 26: 0111110000111110
-        0x00, 0x00,  // Row 27: 0000000000000000
-        0x00, 0x00,  // Row 28: 0000000000000000
-        0x00, 0x00,  // Row 29: 0000000000000000
-        0x00, 0x00,  // Row 30: 0000000000000000
-        0x00, 0x00,  // Row 31: 0000000000000000
-        0x00, 0x00,  // Row 32: 0000000000000000
-    };
-
-    // Set memory destination for user-characters - 00b user characters
-    WriteRegister(0x03);
-    uint8_t temp = 0;
-    temp |= (0 << 0);
-    temp |= (0 << 1);
-    WriteData(temp);
 
-    for (uint8_t i = 0; i < 64; i++) {
-        WriteRegister(0x04);
-        WriteData(ohm[i]);
+// Start double buffering, once at boot when the displayed page is complete. Blocking, not in a display list.
+void LT_PageInit(void) {
+    LT_BteSetup(MAIN_IMAGE_START, LCD_XSIZE_TFT, BACK_IMAGE_START, LCD_XSIZE_TFT);
+    LT_BteCopy(0, 0, 0, 0, LCD_XSIZE_TFT, LCD_YSIZE_TFT);  // Both pages the same to start with
+
+    // Enable the VSYNC time base interrupt so its flag is latched in INTF for LT_WaitVsync(), INT# is not used
+    WriteRegister(0x0B);
+    uint8_t inten = ReadData();
+    WriteData(inten | LT_INT_VSYNC);
+
+    pageShown = MAIN_IMAGE_START;
+    pageDrawn = BACK_IMAGE_START;
+    pageDirtyCount = 0;
+    pageDirtyAll = false;
+    pageEnabled = true;
+    LT_SetCanvas(pageDrawn, LCD_XSIZE_TFT, LCD_YSIZE_TFT);
+}
+
+
+// Page being drawn, the destination for BTE copies onto the screen
+uint32_t LT_PageDrawn(void) {
+    return pageDrawn;
+}
+
+
+// Record a rectangle drawn into the hidden page this pass
+void LT_PageDirty(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    if (!pageEnabled || pageDirtyAll) return;
+
+    if (x >= LCD_XSIZE_TFT || y >= LCD_YSIZE_TFT) return;
+    if (x + w > LCD_XSIZE_TFT) w = LCD_XSIZE_TFT - x;
+    if (y + h > LCD_YSIZE_TFT) h = LCD_YSIZE_TFT - y;
+
+    for (uint8_t i = 0; i < pageDirtyCount; i++) {
+        PageRect* r = &pageDirty[i];
+        if (r->x == x && r->w == w) {
+            uint16_t top = (y < r->y) ? y : r->y;
+            uint16_t bottom = (y + h > r->y + r->h) ? (y + h) : (r->y + r->h);
+            r->y = top;
+            r->h = bottom - top;
+            return;
+        }
     }
 
+    if (pageDirtyCount >= LT_PAGE_DIRTY_MAX) {
+        pageDirtyAll = true;
+        return;
+    }
+    pageDirty[pageDirtyCount++] = (PageRect){ x, y, w, h };
 }
 
 
-// UGC symbol - 12x24
-void Ohms12x24SymbolStoreUCG() {
-    // CGRAM_START_ADDR 0x1000  // Base address for CGRAM
-    // UGC_CODE 0x0000 // UGC code for 16/32 & 12x24 OHM symbols
-    // CGRAM ADDR + (UGC_CODE * 48);  // Calculate UCG address for 12x24
-
-    // 12x24 UCG data for the Ohm symbol
-    // written to 1000h
-    uint8_t ohm[48] = {
-        0x00, 0x00,  // Row 1:  000000000000
-        0x00, 0x00,  // Row 2:  000000000000
-        0x00, 0x00,  // Row 3:  000000000000
-        0x00, 0x00,  // Row 4:  000000000000
-        0x00, 0x00,  // Row 5:  000000000000
-        0x07, 0x00,  // Row 6:  000001110000
-        0x0F, 0x80,  // Row 7:  000011111000
-        0x18, 0xC0,  // Row 8:  000110001100
-        0x30, 0x60,  // Row 9:  001100000110
-        0x30, 0x60,  // Row 10: 001100000110
-        0x30, 0x60,  // Row 11: 001100000110
-        0x30, 0x60,  // Row 12: 001100000110
-        0x30, 0x60,  // Row 13: 001100000110
-        0x30, 0x60,  // Row 14: 001100000110
-        0x18, 0xC0,  // Row 15: 000110001100
-        0x0C, 0xC0,  // Row 16: 000011001100
-        0x0C, 0xC0,  // Row 17: 000011001100
-        0x3C, 0xF0,  // Row 18: 011110001111
-        0x3C, 0xF0,  // Row 19: 011110001111
-        0x00, 0x00,  // Row 20: 000000000000
-        0x00, 0x00,  // Row 21: 000000000000
-        0x00, 0x00,  // Row 22: 000000000000
-        0x00, 0x00,  // Row 23: 000000000000
-        0x00, 0x00   // Row 24: 000000000000
-    };
-
-
-    // Set memory destination for user-characters - 00b user characters
-    WriteRegister(0x03);
-    uint8_t temp = 0;
-    temp |= (0 << 0);
-    temp |= (0 << 1);
-    WriteData(temp);
+// Show the page drawn this pass at the next vertical blank, then bring the other page up to date and draw into it
+void LT_PageFlip(void) {
+    if (!pageEnabled || (pageDirtyCount == 0 && !pageDirtyAll)) return;
+
+    LT_WaitIdle();                                  // Everything drawn
+    LT_WaitVsync();
+    LT_SetMISA(pageDrawn);
+
+    uint32_t page = pageShown;
+    pageShown = pageDrawn;
+    pageDrawn = page;
+    ltPageFlips++;
+
+    LT_BteSetup(pageShown, LCD_XSIZE_TFT, pageDrawn, LCD_XSIZE_TFT);
+    if (pageDirtyAll) {
+        LT_BteCopy(0, 0, 0, 0, LCD_XSIZE_TFT, LCD_YSIZE_TFT);
+    } else {
+        for (uint8_t i = 0; i < pageDirtyCount; i++) {
+            const PageRect* r = &pageDirty[i];
+            LT_BteCopy(r->x, r->y, r->x, r->y, r->w, r->h);
+        }
+    }
+    pageDirtyCount = 0;
+    pageDirtyAll = false;
+
+    LT_SetCanvas(pageDrawn, LCD_XSIZE_TFT, LCD_YSIZE_TFT);
+}
+
+
+
+
+
+//**************************************************************************************************
+// User-defined characters (UCG)
+// The VFD symbols the LT7680 CGROM doesn't have (Ohm, micro, degree, arrows) are drawn as user-defined
+// characters. Each symbol, in each of the two sizes used (16x32 for MAIN, 12x24 for AUX), is uploaded once at
+// boot to its own UCG code by LT_UcgInit(); rendering then only has to send the code.
+//
+// The LT7680 finds UCG code n at CGRAM start address + n * (bytes per character): 64 for 16x32, 48 for 12x24.
+// The allocator packs the glyphs one after another in CGRAM, rounding each up to a whole slot of its own size,
+// so the codes of the two sizes never overlap. CGRAM sits in SDRAM well clear of the display canvas.
+// Rows are 2 bytes, MSB = leftmost pixel (12x24 uses the top 12 bits).
+
+static const uint8_t UcgOhm16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x0F, 0xF0,  // Row 7:  0000111111110000
+    0x1F, 0xF8,  // Row 8:  0001111111111000
+    0x30, 0x0C,  // Row 9:  0011000000001100
+    0x60, 0x06,  // Row 10: 0110000000000110
+    0x60, 0x06,  // Row 11: 0110000000000110
+    0x60, 0x06,  // Row 12: 0110000000000110
+    0x60, 0x06,  // Row 13: 0110000000000110
+    0x60, 0x06,  // Row 14: 0110000000000110
+    0x60, 0x06,  // Row 15: 0110000000000110
+    0x60, 0x06,  // Row 16: 0110000000000110
+    0x60, 0x06,  // Row 17: 0110000000000110
+    0x60, 0x06,  // Row 18: 0110000000000110
+    0x60, 0x06,  // Row 19: 0110000000000110
+    0x30, 0x0C,  // Row 20: 0011000000001100
+    0x18, 0x18,  // Row 21: 0001100000011000
+    0x0C, 0x30,  // Row 22: 0000110000110000
+    0x0C, 0x30,  // Row 23: 0000110000110000
+    0x0C, 0x30,  // Row 24: 0000110000110000
+    0x7C, 0x3E,  // Row 25: 0111110000111110
+    0x7C, 0x3E,  // Row 26: 0111110000111110
+    0x00, 0x00,  // Row 27: 0000000000000000
+    0x00, 0x00,  // Row 28: 0000000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00,  // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgMicro16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x00, 0x00,  // Row 7:  0000000000000000
+    0x00, 0x00,  // Row 8:  0000000000000000
+    0x00, 0x00,  // Row 9:  0000000000000000
+    0x00, 0x00,  // Row 10: 0000000000000000
+    0x00, 0x00,  // Row 11: 0000000000000000
+    0x60, 0x30,  // Row 12: 0110000000110000
+    0x60, 0x30,  // Row 13: 0110000000110000
+    0x60, 0x30,  // Row 14: 0110000000110000
+    0x60, 0x30,  // Row 15: 0110000000110000
+    0x60, 0x30,  // Row 16: 0110000000110000
+    0x60, 0x30,  // Row 17: 0110000000110000
+    0x60, 0x30,  // Row 18: 0110000000110000
+    0x60, 0x30,  // Row 19: 0110000000110000
+    0x60, 0x70,  // Row 20: 0110000001110000
+    0x70, 0xF0,  // Row 21: 0111000011110000
+    0x6F, 0x38,  // Row 22: 0110111100111000
+    0x66, 0x18,  // Row 23: 0110011000011000
+    0x60, 0x00,  // Row 24: 0110000000000000
+    0x60, 0x00,  // Row 25: 0110000000000000
+    0x60, 0x00,  // Row 26: 0110000000000000
+    0x60, 0x00,  // Row 27: 0110000000000000
+    0x60, 0x00,  // Row 28: 0110000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00   // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgDegree16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x07, 0x80,  // Row 7:  0000011110000000
+    0x0C, 0xC0,  // Row 8:  0000110011000000
+    0x18, 0x60,  // Row 9:  0001100001100000
+    0x18, 0x60,  // Row 10: 0001100001100000
+    0x0C, 0xC0,  // Row 11: 0000110011000000
+    0x07, 0x80,  // Row 12: 0000011110000000
+    0x00, 0x00,  // Row 13: 0000000000000000
+    0x00, 0x00,  // Row 14: 0000000000000000
+    0x00, 0x00,  // Row 15: 0000000000000000
+    0x00, 0x00,  // Row 16: 0000000000000000
+    0x00, 0x00,  // Row 17: 0000000000000000
+    0x00, 0x00,  // Row 18: 0000000000000000
+    0x00, 0x00,  // Row 19: 0000000000000000
+    0x00, 0x00,  // Row 20: 0000000000000000
+    0x00, 0x00,  // Row 21: 0000000000000000
+    0x00, 0x00,  // Row 22: 0000000000000000
+    0x00, 0x00,  // Row 23: 0000000000000000
+    0x00, 0x00,  // Row 24: 0000000000000000
+    0x00, 0x00,  // Row 25: 0000000000000000
+    0x00, 0x00,  // Row 26: 0000000000000000
+    0x00, 0x00,  // Row 27: 0000000000000000
+    0x00, 0x00,  // Row 28: 0000000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00   // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgArrowUp16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x00, 0x00,  // Row 7:  0000000000000000
+    0x00, 0x00,  // Row 8:  0000000000000000
+    0x00, 0x00,  // Row 9:  0000000000000000
+    0x00, 0x00,  // Row 10: 0000000000000000
+    0x01, 0x80,  // Row 11: 0000000110000000
+    0x03, 0xC0,  // Row 12: 0000001111000000
+    0x07, 0xE0,  // Row 13: 0000011111100000
+    0x0F, 0xF0,  // Row 14: 0000111111110000
+    0x1F, 0xF8,  // Row 15: 0001111111111000
+    0x3F, 0xFC,  // Row 16: 0011111111111100
+    0x7F, 0xFE,  // Row 17: 0111111111111110
+    0x00, 0x00,  // Row 18: 0000000000000000
+    0x00, 0x00,  // Row 19: 0000000000000000
+    0x00, 0x00,  // Row 20: 0000000000000000
+    0x00, 0x00,  // Row 21: 0000000000000000
+    0x00, 0x00,  // Row 22: 0000000000000000
+    0x00, 0x00,  // Row 23: 0000000000000000
+    0x00, 0x00,  // Row 24: 0000000000000000
+    0x00, 0x00,  // Row 25: 0000000000000000
+    0x00, 0x00,  // Row 26: 0000000000000000
+    0x00, 0x00,  // Row 27: 0000000000000000
+    0x00, 0x00,  // Row 28: 0000000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00   // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgArrowDown16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x00, 0x00,  // Row 7:  0000000000000000
+    0x00, 0x00,  // Row 8:  0000000000000000
+    0x00, 0x00,  // Row 9:  0000000000000000
+    0x00, 0x00,  // Row 10: 0000000000000000
+    0x7F, 0xFE,  // Row 11: 0111111111111110
+    0x3F, 0xFC,  // Row 12: 0011111111111100
+    0x1F, 0xF8,  // Row 13: 0001111111111000
+    0x0F, 0xF0,  // Row 14: 0000111111110000
+    0x07, 0xE0,  // Row 15: 0000011111100000
+    0x03, 0xC0,  // Row 16: 0000001111000000
+    0x01, 0x80,  // Row 17: 0000000110000000
+    0x00, 0x00,  // Row 18: 0000000000000000
+    0x00, 0x00,  // Row 19: 0000000000000000
+    0x00, 0x00,  // Row 20: 0000000000000000
+    0x00, 0x00,  // Row 21: 0000000000000000
+    0x00, 0x00,  // Row 22: 0000000000000000
+    0x00, 0x00,  // Row 23: 0000000000000000
+    0x00, 0x00,  // Row 24: 0000000000000000
+    0x00, 0x00,  // Row 25: 0000000000000000
+    0x00, 0x00,  // Row 26: 0000000000000000
+    0x00, 0x00,  // Row 27: 0000000000000000
+    0x00, 0x00,  // Row 28: 0000000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00   // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgArrowRight16x32[64] = {
+    0x00, 0x00,  // Row 1:  0000000000000000
+    0x00, 0x00,  // Row 2:  0000000000000000
+    0x00, 0x00,  // Row 3:  0000000000000000
+    0x00, 0x00,  // Row 4:  0000000000000000
+    0x00, 0x00,  // Row 5:  0000000000000000
+    0x00, 0x00,  // Row 6:  0000000000000000
+    0x00, 0x00,  // Row 7:  0000000000000000
+    0x00, 0x00,  // Row 8:  0000000000000000
+    0x00, 0x00,  // Row 9:  0000000000000000
+    0x00, 0x60,  // Row 10: 0000000001100000
+    0x00, 0x30,  // Row 11: 0000000000110000
+    0x00, 0x18,  // Row 12: 0000000000011000
+    0x00, 0x0C,  // Row 13: 0000000000001100
+    0x7F, 0xFE,  // Row 14: 0111111111111110
+    0x7F, 0xFE,  // Row 15: 0111111111111110
+    0x00, 0x0C,  // Row 16: 0000000000001100
+    0x00, 0x18,  // Row 17: 0000000000011000
+    0x00, 0x30,  // Row 18: 0000000000110000
+    0x00, 0x60,  // Row 19: 0000000001100000
+    0x00, 0x00,  // Row 20: 0000000000000000
+    0x00, 0x00,  // Row 21: 0000000000000000
+    0x00, 0x00,  // Row 22: 0000000000000000
+    0x00, 0x00,  // Row 23: 0000000000000000
+    0x00, 0x00,  // Row 24: 0000000000000000
+    0x00, 0x00,  // Row 25: 0000000000000000
+    0x00, 0x00,  // Row 26: 0000000000000000
+    0x00, 0x00,  // Row 27: 0000000000000000
+    0x00, 0x00,  // Row 28: 0000000000000000
+    0x00, 0x00,  // Row 29: 0000000000000000
+    0x00, 0x00,  // Row 30: 0000000000000000
+    0x00, 0x00,  // Row 31: 0000000000000000
+    0x00, 0x00   // Row 32: 0000000000000000
+};
+
+static const uint8_t UcgOhm12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x00, 0x00,  // Row 5:  000000000000
+    0x07, 0x00,  // Row 6:  000001110000
+    0x0F, 0x80,  // Row 7:  000011111000
+    0x18, 0xC0,  // Row 8:  000110001100
+    0x30, 0x60,  // Row 9:  001100000110
+    0x30, 0x60,  // Row 10: 001100000110
+    0x30, 0x60,  // Row 11: 001100000110
+    0x30, 0x60,  // Row 12: 001100000110
+    0x30, 0x60,  // Row 13: 001100000110
+    0x30, 0x60,  // Row 14: 001100000110
+    0x18, 0xC0,  // Row 15: 000110001100
+    0x0C, 0xC0,  // Row 16: 000011001100
+    0x0C, 0xC0,  // Row 17: 000011001100
+    0x3C, 0xF0,  // Row 18: 011110001111
+    0x3C, 0xF0,  // Row 19: 011110001111
+    0x00, 0x00,  // Row 20: 000000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+static const uint8_t UcgMicro12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x00, 0x00,  // Row 5:  000000000000
+    0x00, 0x00,  // Row 6:  000000000000
+    0x00, 0x00,  // Row 7:  000000000000
+    0x00, 0x00,  // Row 8:  000000000000
+    0x61, 0x80,  // Row 9:  011000011000
+    0x61, 0x80,  // Row 10: 011000011000
+    0x61, 0x80,  // Row 11: 011000011000
+    0x61, 0x80,  // Row 12: 011000011000
+    0x61, 0x80,  // Row 13: 011000011000
+    0x63, 0x80,  // Row 14: 011000111000
+    0x77, 0x80,  // Row 15: 011101111000
+    0x6C, 0xC0,  // Row 16: 011011001100
+    0x60, 0x00,  // Row 17: 011000000000
+    0x60, 0x00,  // Row 18: 011000000000
+    0x60, 0x00,  // Row 19: 011000000000
+    0x60, 0x00,  // Row 20: 011000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+static const uint8_t UcgDegree12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x0E, 0x00,  // Row 5:  000011100000
+    0x1B, 0x00,  // Row 6:  000110110000
+    0x1B, 0x00,  // Row 7:  000110110000
+    0x0E, 0x00,  // Row 8:  000011100000
+    0x00, 0x00,  // Row 9:  000000000000
+    0x00, 0x00,  // Row 10: 000000000000
+    0x00, 0x00,  // Row 11: 000000000000
+    0x00, 0x00,  // Row 12: 000000000000
+    0x00, 0x00,  // Row 13: 000000000000
+    0x00, 0x00,  // Row 14: 000000000000
+    0x00, 0x00,  // Row 15: 000000000000
+    0x00, 0x00,  // Row 16: 000000000000
+    0x00, 0x00,  // Row 17: 000000000000
+    0x00, 0x00,  // Row 18: 000000000000
+    0x00, 0x00,  // Row 19: 000000000000
+    0x00, 0x00,  // Row 20: 000000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+static const uint8_t UcgArrowUp12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x00, 0x00,  // Row 5:  000000000000
+    0x00, 0x00,  // Row 6:  000000000000
+    0x00, 0x00,  // Row 7:  000000000000
+    0x06, 0x00,  // Row 8:  000001100000
+    0x0F, 0x00,  // Row 9:  000011110000
+    0x1F, 0x80,  // Row 10: 000111111000
+    0x3F, 0xC0,  // Row 11: 001111111100
+    0x7F, 0xE0,  // Row 12: 011111111110
+    0x00, 0x00,  // Row 13: 000000000000
+    0x00, 0x00,  // Row 14: 000000000000
+    0x00, 0x00,  // Row 15: 000000000000
+    0x00, 0x00,  // Row 16: 000000000000
+    0x00, 0x00,  // Row 17: 000000000000
+    0x00, 0x00,  // Row 18: 000000000000
+    0x00, 0x00,  // Row 19: 000000000000
+    0x00, 0x00,  // Row 20: 000000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+static const uint8_t UcgArrowDown12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x00, 0x00,  // Row 5:  000000000000
+    0x00, 0x00,  // Row 6:  000000000000
+    0x00, 0x00,  // Row 7:  000000000000
+    0x7F, 0xE0,  // Row 8:  011111111110
+    0x3F, 0xC0,  // Row 9:  001111111100
+    0x1F, 0x80,  // Row 10: 000111111000
+    0x0F, 0x00,  // Row 11: 000011110000
+    0x06, 0x00,  // Row 12: 000001100000
+    0x00, 0x00,  // Row 13: 000000000000
+    0x00, 0x00,  // Row 14: 000000000000
+    0x00, 0x00,  // Row 15: 000000000000
+    0x00, 0x00,  // Row 16: 000000000000
+    0x00, 0x00,  // Row 17: 000000000000
+    0x00, 0x00,  // Row 18: 000000000000
+    0x00, 0x00,  // Row 19: 000000000000
+    0x00, 0x00,  // Row 20: 000000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+static const uint8_t UcgArrowRight12x24[48] = {
+    0x00, 0x00,  // Row 1:  000000000000
+    0x00, 0x00,  // Row 2:  000000000000
+    0x00, 0x00,  // Row 3:  000000000000
+    0x00, 0x00,  // Row 4:  000000000000
+    0x00, 0x00,  // Row 5:  000000000000
+    0x00, 0x00,  // Row 6:  000000000000
+    0x01, 0x80,  // Row 7:  000000011000
+    0x00, 0xC0,  // Row 8:  000000001100
+    0x7F, 0xE0,  // Row 9:  011111111110
+    0x7F, 0xE0,  // Row 10: 011111111110
+    0x00, 0xC0,  // Row 11: 000000001100
+    0x01, 0x80,  // Row 12: 000000011000
+    0x00, 0x00,  // Row 13: 000000000000
+    0x00, 0x00,  // Row 14: 000000000000
+    0x00, 0x00,  // Row 15: 000000000000
+    0x00, 0x00,  // Row 16: 000000000000
+    0x00, 0x00,  // Row 17: 000000000000
+    0x00, 0x00,  // Row 18: 000000000000
+    0x00, 0x00,  // Row 19: 000000000000
+    0x00, 0x00,  // Row 20: 000000000000
+    0x00, 0x00,  // Row 21: 000000000000
+    0x00, 0x00,  // Row 22: 000000000000
+    0x00, 0x00,  // Row 23: 000000000000
+    0x00, 0x00   // Row 24: 000000000000
+};
+
+typedef struct {
+    char ch;                                // Character as decoded by BitmapToChar()
+    const uint8_t* bitmap[LT_UCG_SIZES];    // Per size, LT_UCG_16X32 / LT_UCG_12X24
+} UcgGlyph;
+
+static const UcgGlyph ucgGlyphs[] = {
+    { '$',    { UcgOhm16x32,        UcgOhm12x24 } },         // Ohm, '$' is its placeholder in the VFD font table
+    { '\xB5', { UcgMicro16x32,      UcgMicro12x24 } },
+    { '\xB0', { UcgDegree16x32,     UcgDegree12x24 } },
+    { '\x1E', { UcgArrowUp16x32,    UcgArrowUp12x24 } },
+    { '\x1F', { UcgArrowDown16x32,  UcgArrowDown12x24 } },
+    { '\x1A', { UcgArrowRight16x32, UcgArrowRight12x24 } },
+};
+#define UCG_GLYPHS  (sizeof(ucgGlyphs) / sizeof(ucgGlyphs[0]))
+
+static const uint8_t ucgBytes[LT_UCG_SIZES] = { 64, 48 };   // Bytes per character (and CGRAM slot size)
+static int16_t ucgCode[UCG_GLYPHS][LT_UCG_SIZES];           // Allocated codes, valid once LT_UcgInit() has run
+uint16_t ucgBytesUsed = 0;                                  // CGRAM used, 0 until LT_UcgInit() (LIVE WATCH)
+
+
+// Allocate a UCG code for every glyph in every size and upload them all, once, at boot
+void LT_UcgInit(void) {
+    uint32_t offset = 0;
+
+    // CGRAM start address
+    LT_CmdListBegin();
+    LT_CmdListAdd(0xDB, LT_UCG_CGRAM_ADDR & 0xFF);
+    LT_CmdListAdd(0xDC, (LT_UCG_CGRAM_ADDR >> 8) & 0xFF);
+    LT_CmdListAdd(0xDD, (LT_UCG_CGRAM_ADDR >> 16) & 0xFF);
+    LT_CmdListAdd(0xDE, (LT_UCG_CGRAM_ADDR >> 24) & 0xFF);
+
+    // Graphic mode, linear addressing from the CGRAM address, so the data goes to SDRAM byte after byte
+    LT_CmdListAdd(0x03, 0x00);              // Graphic mode, memory write to image buffer (SDRAM)
+    LT_CmdListAdd(0x5E, 0x04);              // AW_COLOR: linear addressing, 8bpp
+    LT_CmdListAdd(0x5F, LT_UCG_CGRAM_ADDR & 0xFF);      // In linear mode 5Fh-62h are the memory address
+    LT_CmdListAdd(0x60, (LT_UCG_CGRAM_ADDR >> 8) & 0xFF);
+    LT_CmdListAdd(0x61, (LT_UCG_CGRAM_ADDR >> 16) & 0xFF);
+    LT_CmdListAdd(0x62, (LT_UCG_CGRAM_ADDR >> 24) & 0xFF);
+    LT_CmdListSend();
+
+    WriteRegister(0x04);
+    for (uint8_t g = 0; g < UCG_GLYPHS; g++) {
+        for (uint8_t sz = 0; sz < LT_UCG_SIZES; sz++) {
+            uint8_t n = ucgBytes[sz];
+
+            // Round up to a whole slot of this size, padding the gap
+            uint32_t slot = (offset + n - 1) / n;
+            while (offset < slot * n) {
+                WriteData(0x00);
+                offset++;
+            }
+
+            for (uint8_t i = 0; i < n; i++) {
+                WriteData(ucgGlyphs[g].bitmap[sz][i]);
+            }
+            offset += n;
+            ucgCode[g][sz] = (int16_t)slot;
+        }
+    }
+    ucgBytesUsed = (uint16_t)offset;
+    LT_WaitIdle();
+
+    // Back to block (X-Y) addressing at 16bpp and text mode
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x5E, 0x01);              // AW_COLOR: block mode, 16bpp, as SetColorDepth_LT()
+    LT_CmdListSend();
+    ResetGraphicWritePosition_LT();
+    SetGraphicRWYCoordinate_LT();
+    Text_Mode();
+}
+
 
-    for (uint8_t i = 0; i < 48; i++) {
-        WriteRegister(0x04);
-        WriteData(ohm[i]);
+// UCG code for character c in the given size, or -1 if it is an ordinary CGROM character
+// Also -1 before LT_UcgInit(), nothing has been uploaded yet and CGROM is drawn instead.
+int16_t LT_UcgCode(char c, uint8_t size) {
+    if (ucgBytesUsed == 0) return -1;
+    for (uint8_t g = 0; g < UCG_GLYPHS; g++) {
+        if (ucgGlyphs[g].ch == c) return ucgCode[g][size];
     }
+    return -1;
+}
+
 
+// Draw UCG code 'code' at the text cursor, the font registers must already select the user-defined font
+void LT_UcgDraw(int16_t code) {
+    WriteRegister(0x04);
+    WriteData((uint8_t)(code >> 8));        // High byte
+    WriteData((uint8_t)code);               // Low byte
 }
 
+
 // Print character to LCD
 void ConfigureFontAndPosition(uint8_t fontSource, uint8_t characterHeight, uint8_t isoCoding, uint8_t fullAlignment, uint8_t chromaKeying, uint8_t rotation, uint8_t widthFactor, uint8_t heightFactor, uint8_t lineGap, uint8_t charSpacing, uint16_t cursorX, uint16_t cursorY) {
 
@@ -436,8 +1262,8 @@ void ConfigureFontAndPosition(uint8_t fontSource, uint8_t characterHeight, uint8
     ccr0 |= ((characterHeight & 0b11) << 4);    // Character height
     ccr0 |= (isoCoding & 0b11);                 // ISO coding
 
-    WriteRegister(0xCC); // Write to CCR0
-    WriteData(ccr0);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0xCC, ccr0); // Write to CCR0
 
     // Configure CCR1 (REG[CDh])
     ccr1 |= (fullAlignment << 7);               // Full alignment
@@ -446,72 +1272,31 @@ void ConfigureFontAndPosition(uint8_t fontSource, uint8_t characterHeight, uint8
     ccr1 |= ((widthFactor & 0b11) << 2);        // Character width enlargement
     ccr1 |= (heightFactor & 0b11);              // Character height enlargement
 
-    WriteRegister(0xCD); // Write to CCR1
-    WriteData(ccr1);
+    LT_CmdListAdd(0xCD, ccr1); // Write to CCR1
 
     // Configure Character Line Gap (REG[D0h])
-    WriteRegister(0xD0);
-    WriteData(lineGap & 0x1F); // Line gap (5 bits)
+    LT_CmdListAdd(0xD0, lineGap & 0x1F); // Line gap (5 bits)
 
     // Configure Character-to-Character Space (REG[D1h])
-    WriteRegister(0xD1);
-    WriteData(charSpacing & 0x3F); // Character spacing (6 bits)
+    LT_CmdListAdd(0xD1, charSpacing & 0x3F); // Character spacing (6 bits)
 
     // Set Cursor Position
-    WriteRegister(0x63); // X lower byte
-    WriteData(cursorX & 0xFF);
-    WriteRegister(0x64); // X upper byte
-    WriteData((cursorX >> 8) & 0x1F);
+    LT_CmdListAdd(0x63, cursorX & 0xFF); // X lower byte
+    LT_CmdListAdd(0x64, (cursorX >> 8) & 0x1F); // X upper byte
 
-    WriteRegister(0x65); // Y lower byte
-    WriteData(cursorY & 0xFF);
-    WriteRegister(0x66); // Y upper byte
-    WriteData((cursorY >> 8) & 0x1F);
+    LT_CmdListAdd(0x65, cursorY & 0xFF); // Y lower byte
+    LT_CmdListAdd(0x66, (cursorY >> 8) & 0x1F); // Y upper byte
+    LT_CmdListSend();
 }
 
 
 
 
 void ClearScreen() {
-    uint16_t charWidth = 8;      // Character width in pixels
-    uint16_t charHeight = 16;    // Character height in pixels
-
-    SetTextColors(0x000000, 0x000000); // foreground, background - black
-
-    // Configure the font and position once
-    ConfigureFontAndPosition(
-        0b00,    // Internal CGROM
-        0b00,    // Font size
-        0b00,    // ISO 8859-1
-        0,       // Full alignment disabled
-        0,       // Chroma keying disabled
-        1,       // Rotate 90 degrees counterclockwise
-        0b01,    // Width X1
-        0b01,    // Height X1
-        0,       // Line spacing
-        0,       // Char spacing
-        0,       // Cursor X
-        0        // Cursor Y
-    );
 
-    // Iterate through rows and columns
-    for (uint16_t y = 0; y < LCD_YSIZE_TFT; y += charWidth) {   // In rotation, width becomes Y step
-        for (uint16_t x = 0; x < LCD_XSIZE_TFT; x += charHeight) { // In rotation, height becomes X step
-            // Set cursor position
-            WriteRegister(0x63); // X lower byte
-            WriteData(x & 0xFF);
-            WriteRegister(0x64); // X upper byte
-            WriteData((x >> 8) & 0x1F);
-
-            WriteRegister(0x65); // Y lower byte
-            WriteData(y & 0xFF);
-            WriteRegister(0x66); // Y upper byte
-            WriteData((y >> 8) & 0x1F);
-
-            // Print the character
-            DrawText(" ");
-        }
-    }
+    // One filled rectangle over the whole canvas, replaces ~3000 black spaces drawn in text mode
+    FillRect(0, 0, LCD_XSIZE_TFT - 1, LCD_YSIZE_TFT - 1, 0x00, 0x00, 0x00);
+    LT_WaitIdle();
 
 }
 
@@ -533,24 +1318,99 @@ void DrawTextChunks(char* text) {
 }
 
 
+// Wait for the memory write FIFO to empty, false if it has not within LT_WAIT_TIMEOUT_US
+static _Bool LT_TextFifoWaitEmpty(void) {
+    uint32_t start = DWT->CYCCNT;
+
+    while (!(ReadStatus() & STSR_WFIFO_EMPTY)) {
+        if (LT_WaitTimedOut(start)) return false;
+    }
+    return true;
+}
+
+
+// Learn how many characters can be written back-to-back from an empty memory write FIFO without it filling.
+// Bursts of 1, 2, 3... characters are sent exactly as DrawText() sends them, in the slowest font (32 dots, X4),
+// and STSR is read after each burst. The largest burst that did not fill the FIFO, less one for margin, is kept.
+// Only faster fonts are used afterwards, so the LT7680 drains at least as much during a real burst.
+// The characters land at the top left and are wiped by the ClearScreen() that follows.
+// A FIFO that never empties (LT7680 not answering) leaves textFifoBurst at 1, one character per status read.
+void LT_TextFifoLearnDepth(void) {
+    uint8_t n;
+
+    SetTextColors(0x000000, 0x000000);      // foreground, background - black
+    ConfigureFontAndPosition(
+        0b00,    // Internal CGROM
+        0b10,    // 32 dots
+        0b00,    // ISO 8859-1
+        0,       // Full alignment disabled
+        0,       // Chroma keying disabled
+        1,       // Rotate 90 degrees counterclockwise
+        0b11,    // Width X4
+        0b11,    // Height X4
+        0,       // Line spacing
+        0,       // Char spacing
+        0,       // Cursor X
+        0        // Cursor Y
+    );
+
+    textFifoBurst = 1;
+    for (n = 1; n <= LT_TEXT_FIFO_MAX; n++) {
+        if (!LT_TextFifoWaitEmpty()) return;
+
+        WriteRegister(0x04);                // Register for writing text
+        for (uint8_t i = 0; i < n; i++) {
+            WriteData(' ');
+        }
+
+        if (ReadStatus() & STSR_WFIFO_FULL) break;
+    }
+    if (!LT_TextFifoWaitEmpty()) return;
+
+    // n is the first burst that filled the FIFO (or LT_TEXT_FIFO_MAX + 1 if it never filled)
+    textFifoBurst = (n > 2) ? (n - 2) : 1;
+}
+
+
 // Draw text with FIFO checking
-void DrawText(char* text) {
-    //WriteRegister(0xBA);       // Set the reads to the SPI Master Status Register
-    
+// STSR is read once per burst. With the FIFO empty up to textFifoBurst characters go out back-to-back,
+// if it is part full one character goes out, and if it is full we poll until it is not. A FIFO still full after
+// LT_WAIT_TIMEOUT_US drops the rest of the text rather than overflow it.
+void DrawText(const char* text) {
+
+    if (displayListRecording) {
+        // Same sequence, the display list engine polls for the FIFO to empty before each burst (between
+        // interrupts, the CPU is not held). The first wait is dropped when the list already waits just before it.
+        while (*text != '\0') {
+            LT_DisplayListWaitStatus(STSR_WFIFO_EMPTY, STSR_WFIFO_EMPTY);
+            WriteRegister(0x04);                                // Register for writing text
+            for (uint8_t i = 0; i < textFifoBurst && *text != '\0'; i++) {
+                WriteData((uint8_t)*text);                      // Write each character
+                ++text;
+            }
+        }
+        return;
+    }
+
+    uint32_t start = DWT->CYCCNT;
     while (*text != '\0') {
-        WriteRegister(0xBA);                                    // Set the reads to the SPI Master Status Register
-        // Check the Tx FIFO Full Flag (Bit 6 of REG[BAh])
-        uint8_t Registerdata = ReadData();                      // Read the register value
+        uint8_t status = ReadStatus();
 
         // Wait until the FIFO is not full
-        while (Registerdata & (1 << 6)) {
-            WriteRegister(0xBA);                                // Set the reads to the SPI Master Status Register
-            Registerdata = ReadData();                          // Update the register value
+        if (status & STSR_WFIFO_FULL) {
+            textFifoFullPolls++;
+            if (LT_WaitTimedOut(start)) return;
+            continue;
         }
 
+        uint8_t burst = (status & STSR_WFIFO_EMPTY) ? textFifoBurst : 1;
+
         WriteRegister(0x04);                                    // Register for writing text
-        WriteData((uint8_t)*text);                              // Write each character
-        ++text;                                                 // Move to the next character
+        while (burst-- && *text != '\0') {
+            WriteData((uint8_t)*text);                          // Write each character
+            ++text;                                             // Move to the next character
+        }
+        start = DWT->CYCCNT;                                    // Timeout counts from the last burst
     }
 }
 
@@ -570,20 +1430,16 @@ void DrawText(char* text) {                                         // simple ve
 // Set text colours
 void SetTextColors(uint32_t foreground, uint32_t background) {
     // Set foreground color
-    WriteRegister(0xD2); // Foreground Red
-    WriteData((foreground >> 16) & 0xFF);
-    WriteRegister(0xD3); // Foreground Green
-    WriteData((foreground >> 8) & 0xFF);
-    WriteRegister(0xD4); // Foreground Blue
-    WriteData(foreground & 0xFF);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0xD2, (foreground >> 16) & 0xFF); // Foreground Red
+    LT_CmdListAdd(0xD3, (foreground >> 8) & 0xFF); // Foreground Green
+    LT_CmdListAdd(0xD4, foreground & 0xFF); // Foreground Blue
 
     // Set background color
-    WriteRegister(0xD5); // Background Red
-    WriteData((background >> 16) & 0xFF);
-    WriteRegister(0xD6); // Background Green
-    WriteData((background >> 8) & 0xFF);
-    WriteRegister(0xD7); // Background Blue
-    WriteData(background & 0xFF);
+    LT_CmdListAdd(0xD5, (background >> 16) & 0xFF); // Background Red
+    LT_CmdListAdd(0xD6, (background >> 8) & 0xFF); // Background Green
+    LT_CmdListAdd(0xD7, background & 0xFF); // Background Blue
+    LT_CmdListSend();
 }
 
 
@@ -668,33 +1524,33 @@ void Font_Select_UserDefine_Mode(void)
 
 void ConfigureActiveDisplayArea_LT() {
     // Set Active Window to cover the entire screen
-    WriteRegister(0x56); WriteData(0x00);  // X Start Low
-    WriteRegister(0x57); WriteData(0x00);  // X Start High
-    WriteRegister(0x58); WriteData(0x00);  // Y Start Low
-    WriteRegister(0x59); WriteData(0x00);  // Y Start High
-    WriteRegister(0x5A); WriteData((LCD_XSIZE_TFT - 1) & 0xFF);  // X End Low
-    WriteRegister(0x5B); WriteData(((LCD_XSIZE_TFT - 1) >> 8) & 0xFF);  // X End High
-    WriteRegister(0x5C); WriteData((LCD_YSIZE_TFT - 1) & 0xFF);  // Y End Low
-    WriteRegister(0x5D); WriteData(((LCD_YSIZE_TFT - 1) >> 8) & 0xFF);  // Y End High
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x56, 0x00); // X Start Low
+    LT_CmdListAdd(0x57, 0x00); // X Start High
+    LT_CmdListAdd(0x58, 0x00); // Y Start Low
+    LT_CmdListAdd(0x59, 0x00); // Y Start High
+    LT_CmdListAdd(0x5A, (LCD_XSIZE_TFT - 1) & 0xFF); // X End Low
+    LT_CmdListAdd(0x5B, ((LCD_XSIZE_TFT - 1) >> 8) & 0xFF); // X End High
+    LT_CmdListAdd(0x5C, (LCD_YSIZE_TFT - 1) & 0xFF); // Y End Low
+    LT_CmdListAdd(0x5D, ((LCD_YSIZE_TFT - 1) >> 8) & 0xFF); // Y End High
+    LT_CmdListSend();
 }
 
-/*
-void SetTextCursor(uint16_t x, uint16_t y) {                             // - OK
+void SetTextCursor(uint16_t x, uint16_t y) {  // Move the text cursor without touching the font registers, used by the dirty-cell renderer
     // Set X-Coordinate
-    WriteRegister(0x63); // Lower 8 bits of X position
-    WriteData(x & 0xFF);
-    WriteRegister(0x64); // Upper 5 bits of X position
-    WriteData((x >> 8) & 0x1F); // Only bits 12:8 are valid
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x63, x & 0xFF); // Lower 8 bits of X position
+    LT_CmdListAdd(0x64, (x >> 8) & 0x1F); // Only bits 12:8 are valid
 
     // Set Y-Coordinate
-    WriteRegister(0x65); // Lower 8 bits of Y position
-    WriteData(y & 0xFF);
-    WriteRegister(0x66); // Upper 5 bits of Y position
-    WriteData((y >> 8) & 0x1F); // Only bits 12:8 are valid
+    LT_CmdListAdd(0x65, y & 0xFF); // Lower 8 bits of Y position
+    LT_CmdListAdd(0x66, (y >> 8) & 0x1F); // Only bits 12:8 are valid
+    LT_CmdListSend();
 }
 
 
 
+/*
 void DrawText(uint8_t encoding, char *text) {                            // - OK
     // Set the font encoding in Register 0xCC
     uint8_t regValue = (encoding & 0x03); // Encoding occupies Bit 1-0
@@ -840,38 +1696,33 @@ void LT7680_PLL_Initial_LT() {
     unsigned short lpllN_sclk = SCLK, lpllN_cclk = CCLK, lpllN_mclk = MCLK;
 
     // Configure PCLK PLL - TFT pixel clock (max=80MHz) (Registers 0x05 and 0x06)
-    WriteRegister(0x05);
-    WriteData((lpllOD_sclk << 6) | (lpllR_sclk << 1) | ((lpllN_sclk >> 8) & 0x1));      // 8A
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x05, (lpllOD_sclk << 6) | (lpllR_sclk << 1) | ((lpllN_sclk >> 8) & 0x1)); // 8A
     //WriteData(0x56);          // test
     
-    WriteRegister(0x06);
-    WriteData(lpllN_sclk & 0xFF);                                                       // 1B
+    LT_CmdListAdd(0x06, lpllN_sclk & 0xFF); // 1B
     //WriteData(0x10);        // test, fixes wierd colour on the "J" on "IanJ" text, but causes flicker
 
     // Configure MCLK PLL - Display memory clock (max=133MHz) (Registers 0x07 and 0x08)
-    WriteRegister(0x07);
-    WriteData((lpllOD_mclk << 6) | (lpllR_mclk << 1) | ((lpllN_mclk >> 8) & 0x1));      // 8A
+    LT_CmdListAdd(0x07, (lpllOD_mclk << 6) | (lpllR_mclk << 1) | ((lpllN_mclk >> 8) & 0x1)); // 8A
     //WriteData(0x8A);          // test
     
-    WriteRegister(0x08);                // 36
-    WriteData(lpllN_mclk & 0xFF);                                                       // 36
+    LT_CmdListAdd(0x08, lpllN_mclk & 0xFF); // 36
     //WriteData(0x56);          // test
 
     // Configure CCLK PLL - Core clock (max=100MHz) (Registers 0x09 and 0x0A)
-    WriteRegister(0x09);
-    WriteData((lpllOD_cclk << 6) | (lpllR_cclk << 1) | ((lpllN_cclk >> 8) & 0x1));      // 8A
+    LT_CmdListAdd(0x09, (lpllOD_cclk << 6) | (lpllR_cclk << 1) | ((lpllN_cclk >> 8) & 0x1)); // 8A
     //WriteData(0x56);          // test
     
-    WriteRegister(0x0A);
-    WriteData(lpllN_cclk & 0xFF);                                                       // 36
+    LT_CmdListAdd(0x0A, lpllN_cclk & 0xFF); // 36
     //WriteData(0x56);          // test
 
     // Trigger PLL reconfiguration (Register 0x00)
-    WriteRegister(0x00);
-    WriteData(0x80);
+    LT_CmdListAdd(0x00, 0x80);
+    LT_CmdListSend();
 
-    // Add delay to allow PLL settings to stabilize
-    HAL_Delay(10); // delay
+    // Bit 7 reads back 1 once the system has switched to the PLL clocks
+    LT_BootWaitReg(0x00, 0x80, LT_PLL_LOCK_MS);
 }
 
 
@@ -887,34 +1738,34 @@ void Configure_Main_PIP_Window_LT() {
     regValue |= (0 << 0);  // Bit 0: Sync Mode (VSYNC, HSYNC, DE enabled)
 
     // Write the configuration to REG[10h]
-    WriteRegister(0x10);
-    WriteData(regValue);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x10, regValue);
 
     // PIP Window Upper-Left Corner (0,0)
-    WriteRegister(0x2A); WriteData(0x00);  // Upper-left X coord Low Byte
-    WriteRegister(0x2B); WriteData(0x00);  // Upper-left X coord High Byte
-    WriteRegister(0x2C); WriteData(0x00);  // Upper-left Y coord Low Byte
-    WriteRegister(0x2D); WriteData(0x00);  // Upper-left Y coord High Byte
+    LT_CmdListAdd(0x2A, 0x00); // Upper-left X coord Low Byte
+    LT_CmdListAdd(0x2B, 0x00); // Upper-left X coord High Byte
+    LT_CmdListAdd(0x2C, 0x00); // Upper-left Y coord Low Byte
+    LT_CmdListAdd(0x2D, 0x00); // Upper-left Y coord High Byte
 
     // PIP Window Bottom-Right Corner (100,100)
-    WriteRegister(0x2E); WriteData((100 & 0xFC));     // Lower-right X coord Low Byte (ensure bit[1:0] = 0)
-    WriteRegister(0x2F); WriteData((100 >> 8) & 0x1F); // Lower-right X coord High Byte (bits [12:8])
-    WriteRegister(0x30); WriteData(100 & 0xFF);       // Lower-right Y coord Low Byte
-    WriteRegister(0x31); WriteData((100 >> 8) & 0x1F); // Lower-right Y coord High Byte (bits [12:8])
+    LT_CmdListAdd(0x2E, (100 & 0xFC)); // Lower-right X coord Low Byte (ensure bit[1:0] = 0)
+    LT_CmdListAdd(0x2F, (100 >> 8) & 0x1F); // Lower-right X coord High Byte (bits [12:8])
+    LT_CmdListAdd(0x30, 100 & 0xFF); // Lower-right Y coord Low Byte
+    LT_CmdListAdd(0x31, (100 >> 8) & 0x1F); // Lower-right Y coord High Byte (bits [12:8])
 
     // Set PIP Image Start Address to 0x000000 (example, ensure data exists here in SDRAM)
-    WriteRegister(0x32); WriteData(0x00);  // Address bits [7:0]
-    WriteRegister(0x33); WriteData(0x00);  // Address bits [15:8]
-    WriteRegister(0x34); WriteData(0x00);  // Address bits [23:16]
-    WriteRegister(0x35); WriteData(0x00);  // Address bits [31:24]
+    LT_CmdListAdd(0x32, 0x00); // Address bits [7:0]
+    LT_CmdListAdd(0x33, 0x00); // Address bits [15:8]
+    LT_CmdListAdd(0x34, 0x00); // Address bits [23:16]
+    LT_CmdListAdd(0x35, 0x00); // Address bits [31:24]
 
     // Set PIP-1 and PIP-2 color depth to 16bpp (Bits 3-2 and 1-0 set to 01)
     uint8_t regValue2 = 0;
     regValue2 |= (0b01 << 2);  // PIP-1 Color Depth: 16bpp
     regValue2 |= (0b01 << 0);  // PIP-2 Color Depth: 16bpp
     // Write to Register 0x11
-    WriteRegister(0x11);
-    WriteData(regValue2);
+    LT_CmdListAdd(0x11, regValue2);
+    LT_CmdListSend();
 
 }
 
@@ -926,45 +1777,38 @@ void SDRAM_Init_LT() {
     unsigned short sdram_itv;
     uint8_t regValue1 = 0;
 
+    // Calculate SDRAM refresh interval
+    sdram_itv = (SDRAM_CLKFREQ / SDRAM_SIZE) / (1000 / SDRAM_MCLK); // Based on MCLK
+    sdram_itv -= 2;
+
+    LT_CmdListBegin();
+
     // Step 1: Enable SDRAM Timing Parameter Registers (Bit 2 = 1)
-    WriteRegister(0xE4);        // Allow addresses 0xE0 to 0xE3 to be set
     regValue1 |= (1 << 2);      // Set Bit 2
-    WriteData(regValue1);
+    LT_CmdListAdd(0xE4, regValue1);     // Allow addresses 0xE0 to 0xE3 to be set
 
     // Step 2: Configure SDRAM settings
-    WriteRegister(0xE0);        // Register 0xE0: SDRAM Control Register
-    WriteData(0x29);            // Default SDRAM control value specifically for LT7680A-R      LT7680A = 64MB, LT&^*)A-R 128MB I think!   set to 0x21 or 0x29
-
-    WriteRegister(0xE1);        // Register 0xE1: SDRAM CAS Latency
-    WriteData(0x03);            // Set CAS latency to 0x03 as suggested by manual
-
-    // Calculate SDRAM refresh interval
-    sdram_itv = (SDRAM_CLKFREQ / SDRAM_SIZE) / (1000 / SDRAM_MCLK); // Based on MCLK
-    sdram_itv -= 2;
+    LT_CmdListAdd(0xE0, 0x29);          // Register 0xE0: SDRAM Control Register. Default SDRAM control value specifically for LT7680A-R      LT7680A = 64MB, LT&^*)A-R 128MB I think!   set to 0x21 or 0x29
+    LT_CmdListAdd(0xE1, 0x03);          // Register 0xE1: SDRAM CAS Latency. Set CAS latency to 0x03 as suggested by manual
 
     // Write SDRAM interval (lower byte)
-    WriteRegister(0xE2);        // Register 0xE2: SDRAM Refresh Interval Low Byte
-    WriteData(sdram_itv);                                               // sdram_itv & 0xFF
-    //WriteData(0x1A);            // Set to 0x06 as reference setting by manual for LT7680A-R
+    LT_CmdListAdd(0xE2, sdram_itv);     // Register 0xE2: SDRAM Refresh Interval Low Byte          sdram_itv & 0xFF
+    //LT_CmdListAdd(0xE2, 0x1A);        // Set to 0x06 as reference setting by manual for LT7680A-R
 
     // Write SDRAM interval (upper byte)
-    WriteRegister(0xE3);        // Register 0xE3: SDRAM Refresh Interval High Byte
-    WriteData(sdram_itv >> 8);                                 // sdram_itv >> 8) & 0xFF
-    //WriteData(0x06);            // Set to 0x06 as reference setting by manual for LT7680A-R
+    LT_CmdListAdd(0xE3, sdram_itv >> 8);    // Register 0xE3: SDRAM Refresh Interval High Byte     sdram_itv >> 8) & 0xFF
+    //LT_CmdListAdd(0xE3, 0x06);        // Set to 0x06 as reference setting by manual for LT7680A-R
 
     // Step 3: Trigger SDRAM Initialization (Set Bit 0 = 1)
-    WriteRegister(0xE4);
     //regValue1 |= (1 << 0);      // Set Bit 0 (SDR_INITDONE)
-    //WriteData(regValue1);
-    WriteData(0x01);
+    LT_CmdListAdd(0xE4, 0x01);
 
     // Step 4: Disable Timing Parameter Registers (Clear Bit 2)
-    WriteRegister(0xE4);        // Disable, addresses 0xE0 to 0xE3 can no longer be set
     regValue1 &= ~(1 << 2);     // Clear Bit 2
     //regValue1 |= (0 << 2);
-    WriteData(regValue1);
+    LT_CmdListAdd(0xE4, regValue1);     // Disable, addresses 0xE0 to 0xE3 can no longer be set
 
-    HAL_Delay(1); // 1 ms delay
+    LT_CmdListSend();
 
     Check_SDRAM_Ready_LT();     // Call sub to wait for SDRAM initialization to complete
 
@@ -974,16 +1818,10 @@ void SDRAM_Init_LT() {
 // Check if the SDRAM is ready for use - Address = 0xE4
 void Check_SDRAM_Ready_LT() {
     
-    unsigned char status;
-    
-    // Poll the SDRAM Ready Flag (Bit 0) in Register 0xE4
-    do {
-        WriteRegister(0xE4);
-        status = ReadData(); // Read the SDRAM status register
-    } while ((status & 0x01) == 0);  // Wait until the Ready bit (bit 0) is set
-    
-    // Optional delay to ensure SDRAM is stable after initialization
-    HAL_Delay(10);  // 10 ms delay
+    // Poll the SDRAM Ready Flag (Bit 0) in Register 0xE4, then STSR until the SDRAM accepts access
+    if (LT_BootWaitReg(0xE4, 0x01, LT_SDRAM_READY_MS)) {
+        LT_BootWaitStatus(STSR_SDRAM_READY, STSR_SDRAM_READY, LT_SDRAM_READY_MS);
+    }
 
 }
 
@@ -999,24 +1837,22 @@ void Set_LCD_Panel_LT() {
     temp |= (0 << 2);               // Set Bit 2 to 0 (Disable I2C Master)
     temp |= (0 << 5);               // Set Bit 5 to 0 (Disable Keypad-scan)
     temp |= (1 << 6);               // Set Bit 6 to 1 (Mask, WAIT# de-assert when CS# de-assert.)
-    WriteRegister(0x01);
-    WriteData(temp);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x01, temp);
 
     // Configure Register 0x02: Host Read/Write Image Data Format
     temp = 0;                       // Reset temp for next register
     temp |= (0b00 << 6);            // Set Bit 7-6 to 00b (Direct Write using SPI)
     temp |= (0b00 << 4);            // Set Bit 5-4 to 00b (Read: Left to Right, Top to Bottom)
     temp |= (0b00 << 1);            // Set Bit 2-1 to 00b (Write: Left to Right, Top to Bottom)
-    WriteRegister(0x02);
-    WriteData(temp);
+    LT_CmdListAdd(0x02, temp);
 
     // Configure Register 0x03: Graphic Mode and Memory Selection
     temp = 0;                       // Reset temp for next register
     temp |= (0 << 2);               // Set Bit 2 to 1 (Text Mode)
     temp |= (0 << 1);               // Set Bit 1 to 0
     temp |= (0 << 0);               // Set Bit 0 to 0 (Select SDRAM)
-    WriteRegister(0x03);
-    WriteData(temp);
+    LT_CmdListAdd(0x03, temp);
 
     // Configure Display Parameters in Register 0x12
     temp = 0;                       // Reset temp for next register
@@ -1024,8 +1860,7 @@ void Set_LCD_Panel_LT() {
     temp |= (VSCAN_DIRECTION << 3); // Set Bit 3 to 0 (VSCAN Top to Bottom)
     temp |= PD_OUTPUT_SEQ;          // Set Bits 2-0 to 000 (PDATA RGB Mode)
     //temp |= (0b000);
-    WriteRegister(0x12);
-    WriteData(temp);
+    LT_CmdListAdd(0x12, temp);
 
     // Configure Display Parameters in Register 0x13
     temp = 0;                       // Reset temp for next register
@@ -1037,8 +1872,8 @@ void Set_LCD_Panel_LT() {
     temp |= (PD_IDLE_STATE << 2);   // Bit 2
     temp |= (HSYNC_IDLE_STATE << 1);// Bit 1
     temp |= (VSYNC_IDLE_STATE << 0);// Bit 0
-    WriteRegister(0x13);
-    WriteData(temp);
+    LT_CmdListAdd(0x13, temp);
+    LT_CmdListSend();
 
 }
 
@@ -1050,10 +1885,9 @@ void LCD_HorizontalWidth_VerticalHeight_LT(uint16_t WX, uint16_t HY) {
     uint16_t tempWidthFineTune = 0;
 
     // Horizontal Width
-    WriteRegister(0x14);
-    WriteData(tempWidth);
-    WriteRegister(0x15);
-    WriteData(tempWidthFineTune & 0x0F);    // Bits 0-3 only
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x14, tempWidth);
+    LT_CmdListAdd(0x15, tempWidthFineTune & 0x0F); // Bits 0-3 only
 
     // Vertical Height
     // Ensure height is within valid range
@@ -1065,11 +1899,10 @@ void LCD_HorizontalWidth_VerticalHeight_LT(uint16_t WX, uint16_t HY) {
     }
     uint16_t vdhr = HY - 1;             // Subtract 1 from the height as per the formula: VDHR = Vertical Display Height - 1
     // Write the lower 8 bits of VDHR to Register 0x1A
-    WriteRegister(0x1A);
-    WriteData(vdhr & 0xFF); // Lower 8 bits of VDHR
+    LT_CmdListAdd(0x1A, vdhr & 0xFF); // Lower 8 bits of VDHR
     // Write the upper 3 bits of VDHR to Register 0x1B
-    WriteRegister(0x1B);
-    WriteData(vdhr >> 8); // Upper 3 bits of VDHR (bits 10-8)
+    LT_CmdListAdd(0x1B, vdhr >> 8); // Upper 3 bits of VDHR (bits 10-8)
+    LT_CmdListSend();
 
 }
 
@@ -1081,10 +1914,10 @@ void LCD_Horizontal_Non_Display_LT(uint16_t val) {
     uint16_t tempHBPDFineTune = 0;
 
     // Horizontal HBPD
-    WriteRegister(0x16);
-    WriteData(tempHBPD);
-    WriteRegister(0x17);
-    WriteData(tempHBPDFineTune & 0x0F);    // Bits 0-3 only
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x16, tempHBPD);
+    LT_CmdListAdd(0x17, tempHBPDFineTune & 0x0F); // Bits 0-3 only
+    LT_CmdListSend();
 
 }
 
@@ -1131,10 +1964,10 @@ void LCD_HSYNC_Pulse_Width_LT(uint16_t val) {
 void LCD_Vertical_Non_Display_LT(uint16_t val) {
 
     uint8_t temp = val - 1;
-    WriteRegister(0x1C);
-    WriteData(temp & 0xFF);
-    WriteRegister(0x1D);
-    WriteData((temp >> 8) & 0xFF);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x1C, temp & 0xFF);
+    LT_CmdListAdd(0x1D, (temp >> 8) & 0xFF);
+    LT_CmdListSend();
 
 }
 
@@ -1215,13 +2048,12 @@ void ConfigurePWMAndSetBrightness(uint8_t brightnessPercentage) {
     // Step 1: Set the Prescaler (REG[84h])
     // Core Frequency: 54MHz -> Base Frequency = Core_Freq / (Prescaler + 1)
     // Example: Prescaler = 16 -> Base Frequency = 54MHz / (16 + 1) = ~3.18MHz
-    WriteRegister(0x84);
-    WriteData(0x10); // Prescaler = 16
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x84, 0x10); // Prescaler = 16
 
     // Step 2: Configure PWM Clock Mux Register (REG[85h])
     // Timer-1 divisor = 1/4, PWM[1] = Timer-1 events
-    WriteRegister(0x85);
-    WriteData((2 << 6) | // Timer-1 divisor = 1/4
+    LT_CmdListAdd(0x85, (2 << 6) | // Timer-1 divisor = 1/4
         (2 << 2)); // PWM[1] output Timer-1 events
 
     // Step 3: Calculate ON and OFF times for Timer-1
@@ -1230,21 +2062,17 @@ void ConfigurePWMAndSetBrightness(uint8_t brightnessPercentage) {
     uint16_t countValue = 255; // Fixed total period
 
     // Step 4: Set Compare Buffer for Timer-1 (REG[8Ch-8Dh])
-    WriteRegister(0x8C); // Timer-1 Compare Buffer (low byte)
-    WriteData(compareValue & 0xFF);
-    WriteRegister(0x8D); // Timer-1 Compare Buffer (high byte)
-    WriteData((compareValue >> 8) & 0xFF);
+    LT_CmdListAdd(0x8C, compareValue & 0xFF); // Timer-1 Compare Buffer (low byte)
+    LT_CmdListAdd(0x8D, (compareValue >> 8) & 0xFF); // Timer-1 Compare Buffer (high byte)
 
     // Step 5: Set Count Buffer for Timer-1 (REG[8Eh-8Fh])
-    WriteRegister(0x8E); // Timer-1 Count Buffer (low byte)
-    WriteData(countValue & 0xFF);
-    WriteRegister(0x8F); // Timer-1 Count Buffer (high byte)
-    WriteData((countValue >> 8) & 0xFF);
+    LT_CmdListAdd(0x8E, countValue & 0xFF); // Timer-1 Count Buffer (low byte)
+    LT_CmdListAdd(0x8F, (countValue >> 8) & 0xFF); // Timer-1 Count Buffer (high byte)
 
     // Step 6: Enable Timer-1 (REG[86h])
     // Auto-reload enabled, Timer-1 started, no inversion
-    WriteRegister(0x86);
-    WriteData((1 << 5) | (1 << 4)); // Auto-reload and Start
+    LT_CmdListAdd(0x86, (1 << 5) | (1 << 4)); // Auto-reload and Start
+    LT_CmdListSend();
 }
 
 
@@ -1269,6 +2097,7 @@ void Software_Reset_LT() {                                      // OK - needs ve
 
     // Write the configured value to Register 0x00
     WriteDataToRegister(0x00, regValue);
+    bteRegsValid = false;                   // BTE registers are back to their defaults
 
     // Optional: Add a delay to allow reset/reconfiguration to complete
     //HAL_Delay(10);
@@ -1322,10 +2151,12 @@ void Software_ResetPLL_LT() {                                      // OK - needs
 void Set_MISA_LT() {
     
     // Hardcoded Main Image Start Address = 0x00000000
-    WriteRegister(0x20); WriteData(0x00);  // MISA[7:0], ensure bit[1:0] = 0
-    WriteRegister(0x21); WriteData(0x00);  // MISA[15:8]
-    WriteRegister(0x22); WriteData(0x00);  // MISA[23:16]
-    WriteRegister(0x23); WriteData(0x00);  // MISA[31:24]
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x20, 0x00); // MISA[7:0], ensure bit[1:0] = 0
+    LT_CmdListAdd(0x21, 0x00); // MISA[15:8]
+    LT_CmdListAdd(0x22, 0x00); // MISA[23:16]
+    LT_CmdListAdd(0x23, 0x00); // MISA[31:24]
+    LT_CmdListSend();
      
 }
 
@@ -1334,10 +2165,10 @@ void Set_MISA_LT() {
 void SetMainImageWidth_LT() {
 
     // Set to 
-    WriteRegister(0x24);
-    WriteData(LCD_XSIZE_TFT & 0xFF);
-    WriteRegister(0x25);
-    WriteData((LCD_XSIZE_TFT >> 8) & 0x1F);  // Mask to 5 bits
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x24, LCD_XSIZE_TFT & 0xFF);
+    LT_CmdListAdd(0x25, (LCD_XSIZE_TFT >> 8) & 0x1F); // Mask to 5 bits
+    LT_CmdListSend();
 
 }
 
@@ -1352,10 +2183,10 @@ void SetMainWindowUpperLeftX_LT() {
     highByte = (xCoord >> 8) & 0x1F; // Only use bits[12:8] and ignore bits[7:5]
 
     // Write to MWULX registers
-    WriteRegister(0x26);
-    WriteData(lowByte);            // MWULX[7:0]
-    WriteRegister(0x27);
-    WriteData(highByte);           // MWULX[12:8]
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x26, lowByte); // MWULX[7:0]
+    LT_CmdListAdd(0x27, highByte); // MWULX[12:8]
+    LT_CmdListSend();
 
 }
 
@@ -1363,8 +2194,10 @@ void SetMainWindowUpperLeftX_LT() {
 // Registers 0x28, 0x29
 void SetActiveWindow_LT() {
     // Main Window Horizontal Start = 0, End = 319
-    WriteRegister(0x28); WriteData(0x00);  // Start X Low Byte
-    WriteRegister(0x29); WriteData(0x00);  // Start X High Byte
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x28, 0x00); // Start X Low Byte
+    LT_CmdListAdd(0x29, 0x00); // Start X High Byte
+    LT_CmdListSend();
 
 }
 
@@ -1392,12 +2225,12 @@ void SetColorDepth_LT() {
 
 void ResetGraphicWritePosition_LT() {
     // Set Graphic Write X-Coordinate to 0 (lower 8 bits)
-    WriteRegister(0x5F);
-    WriteData(0x00);
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x5F, 0x00);
 
     // Set Graphic Write X-Coordinate to 0 (upper 5 bits)
-    WriteRegister(0x60);
-    WriteData(0x00);
+    LT_CmdListAdd(0x60, 0x00);
+    LT_CmdListSend();
 }
 
 
@@ -1405,38 +2238,36 @@ void SetGraphicRWYCoordinate_LT() {
     uint16_t y = 0;  // Hardcoded to 0 for the initial Y-coordinate
 
     // Write to REG[61h] (Lower byte of Y-coordinate)
-    WriteRegister(0x61);
-    WriteData(y & 0xFF);  // Lower 8 bits of the Y-coordinate
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x61, y & 0xFF); // Lower 8 bits of the Y-coordinate
 
     // Write to REG[62h] (Upper byte of Y-coordinate)
-    WriteRegister(0x62);
-    WriteData((y >> 8) & 0x1F);  // Bits [12:8], masked to 5 bits
+    LT_CmdListAdd(0x62, (y >> 8) & 0x1F); // Bits [12:8], masked to 5 bits
+    LT_CmdListSend();
 }
 
 
 void SetCanvasStartAddress_LT() {
     uint32_t startAddress = 0x00000000;  // Hardcoded to 0 (start of SDRAM)
 
-    WriteRegister(0x50);
-    WriteData(startAddress & 0xFF);         // Lower byte (CVSSA[7:0])
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x50, startAddress & 0xFF); // Lower byte (CVSSA[7:0])
 
-    WriteRegister(0x51);
-    WriteData((startAddress >> 8) & 0xFF);  // Middle byte (CVSSA[15:8])
+    LT_CmdListAdd(0x51, (startAddress >> 8) & 0xFF); // Middle byte (CVSSA[15:8])
 
-    WriteRegister(0x52);
-    WriteData((startAddress >> 16) & 0xFF); // Upper byte (CVSSA[23:16])
+    LT_CmdListAdd(0x52, (startAddress >> 16) & 0xFF); // Upper byte (CVSSA[23:16])
 
-    WriteRegister(0x53);
-    WriteData((startAddress >> 24) & 0xFF); // Highest byte (CVSSA[31:24])
+    LT_CmdListAdd(0x53, (startAddress >> 24) & 0xFF); // Highest byte (CVSSA[31:24])
+    LT_CmdListSend();
 
 }
 
 
 void SetCanvasImageWidth_LT() {
-    WriteRegister(0x54);
-    WriteData(LCD_XSIZE_TFT & 0xFF);          // Lower byte (CVS_IMWTH[7:0])
+    LT_CmdListBegin();
+    LT_CmdListAdd(0x54, LCD_XSIZE_TFT & 0xFF); // Lower byte (CVS_IMWTH[7:0])
 
-    WriteRegister(0x55);
-    WriteData((LCD_XSIZE_TFT >> 8) & 0x3F);   // Upper byte (CVS_IMWTH[13:8]), masked to 6 bits
+    LT_CmdListAdd(0x55, (LCD_XSIZE_TFT >> 8) & 0x3F); // Upper byte (CVS_IMWTH[13:8]), masked to 6 bits
+    LT_CmdListSend();
 }
 
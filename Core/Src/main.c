@@ -26,10 +26,15 @@
 #include <string.h>
 #include <stdint.h>
 #include "lt7680.h"
+#include "lcd.h"
 #include "timer.h"
 #include <stdbool.h>    // bool support, otherwise use _Bool
 //#include <stdlib.h> // For rand()
 #include "display.h"
+#include "displaylist.h"
+#include "vfdcapture.h"
+#include "vfdrecord.h"
+#include "profile.h"
 #include "stm32f1xx_hal.h"
 #include <stdlib.h>		// required for float (soft FPU)
 
@@ -82,9 +87,6 @@ uint8_t unmatchedBitmap[FONT_HEIGHT] = { 0 }; // Initialize to zero
 
 //******************************************************************************
 
-// SPI receive buffer for packets data
-volatile uint8_t rx_buffer[PACKET_WIDTH * PACKET_COUNT];
-
 // Array with character bitmaps
 uint8_t chars[CHAR_COUNT][CHAR_HEIGHT];
 
@@ -108,6 +110,31 @@ const uint8_t Reorder[PACKET_COUNT] = { 8, 7, 6, 5, 4, 3, 2, 1, 0, 18, 19, 20, 2
 // Flag indicating finish of SPI transmission to OLED
 volatile uint8_t SPI1_TX_completed_flag = 1;
 
+// VFD frames decoded by the main loop, and per second alongside the frames captured per second (LIVE WATCH)
+uint32_t framesDecoded = 0;
+uint32_t framesDecodedPerSecond = 0;
+uint32_t framesCapturedPerSecond = 0;
+
+// LT7680 SPI bytes and CS transactions per render tick (LIVE WATCH)
+uint32_t renderSpiBytes = 0;
+uint32_t renderSpiTransactions = 0;
+static uint32_t renderSpiBytesLast = 0;
+static uint32_t renderSpiTransactionsLast = 0;
+
+// A decoded frame differs from the one last rendered
+_Bool renderPending = true;
+static uint32_t renderPendingSince = 0;		// DWT cycle count the pending change was captured at
+static uint32_t lastRenderTick = 0;
+
+// Render scheduler bounds, can be tuned live (LIVE WATCH)
+uint32_t renderMinIntervalMs = 20;		// Changes closer together than this are rendered together
+uint32_t renderMaxIdleMs = 500;			// Refresh the screen at least this often even without a change
+
+// Capture-to-render latency in us, last, worst and rolling mean (LIVE WATCH)
+uint32_t renderLatencyUs = 0;
+uint32_t renderLatencyMaxUs = 0;
+uint32_t renderLatencyMeanUs = 0;
+
 // Flag indicating finish of SPI start-up initialization
 volatile uint8_t Init_Completed_flag = 0;
 
@@ -133,6 +160,7 @@ uint32_t setting_LCD_HFPD;
 uint32_t setting_LCD_HSPW;
 uint32_t setting_REFRESH_RATE;
 char setting_ADA_BUY[5];
+uint32_t setting_SPI1_PRESCALER;
 
 //******************************************************************************
 
@@ -150,20 +178,40 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi) {
 }
 
 
-//******************************************************************************
-static uint8_t InverseByte(uint8_t a) {
-	a = ((a & 0x55) << 1) | ((a & 0xAA) >> 1);
-	a = ((a & 0x33) << 2) | ((a & 0xCC) >> 2);
-	return (a >> 4) | (a << 4);
+//SPI reception finished interrupt callback, a complete VFD frame has been captured
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi) {
+	if (hspi->Instance == SPI2)
+	{
+		VFD_CapturePublish();
+	}
 }
 
 
 //******************************************************************************
-// Function to map character bitmaps to ASCII characters
-typedef struct {
-	uint8_t bitmap[7]; // 7 bytes for 5x7 character bitmaps
-	char ascii;        // Corresponding ASCII character
-} BitmapChar;
+// Bit-reverse lookup used by Packets_to_chars(). Entry x is x with its bit order reversed, masked to the 5 columns
+// of a character row, i.e. what 0x1F & InverseByte(x) used to compute with shifts for every row of every cell.
+static const uint8_t RowReverse[256] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+	0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+	0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14, 0x14,
+	0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C,
+	0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+	0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x1A, 0x1A, 0x1A, 0x1A, 0x1A, 0x1A, 0x1A, 0x1A,
+	0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x16, 0x16, 0x16, 0x16, 0x16, 0x16, 0x16, 0x16,
+	0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x0E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E,
+	0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x19, 0x19, 0x19, 0x19, 0x19, 0x19, 0x19, 0x19,
+	0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15, 0x15,
+	0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x0D, 0x1D, 0x1D, 0x1D, 0x1D, 0x1D, 0x1D, 0x1D, 0x1D,
+	0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x13, 0x13, 0x13, 0x13, 0x13, 0x13, 0x13, 0x13,
+	0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x1B, 0x1B, 0x1B, 0x1B, 0x1B, 0x1B, 0x1B, 0x1B,
+	0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17,
+	0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F
+};
+
+
+//******************************************************************************
+// Function to map character bitmaps to ASCII characters (BitmapChar is in main.h)
 
 
 // Font data: 96 characters, 7 bytes per character (each row)
@@ -265,9 +313,9 @@ const BitmapChar bitmap_characters[] = {
 	{{0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, '}'},  // 0x7D, }
 	{{0x00, 0x00, 0x09, 0x15, 0x12, 0x00, 0x00}, '~'},  // 0x7E, ~
 	{{0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, '/'},  // forward slash
-	{{0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00}, '°'},	// DegC symbol
+	{{0x06, 0x09, 0x09, 0x06, 0x00, 0x00, 0x00}, '\xB0' },	// DegC symbol, ISO 8859-1 degree sign
 	{{0x0E, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x1B}, '$'},	// Ohm symbol placeholder uses the $ symbol for detection of Ohm symbol
-	{{0x11, 0x12, 0x14, 0x0B, 0x11, 0x02, 0x03}, '½'},	// half symbol
+	{{0x11, 0x12, 0x14, 0x0B, 0x11, 0x02, 0x03}, '\xBD' },	// half symbol, ISO 8859-1
 	{{0x00, 0x00, 0x04, 0x0E, 0x1F, 0x00, 0x00}, '\x1E'},	// up arrow
 	{{0x00, 0x00, 0x1F, 0x0E, 0x04, 0x00, 0x00}, '\x1F'},	// down arrow
 	{{0x00, 0x00, 0x09, 0x09, 0x09, 0x09, 0x16}, '\xB5' },	// micro u
@@ -286,15 +334,70 @@ const BitmapChar bitmap_characters[] = {
 };
 
 
+#define BITMAP_CHAR_COUNT (sizeof(bitmap_characters) / sizeof(BitmapChar))
+const uint16_t bitmapCharCount = BITMAP_CHAR_COUNT;
+
+
+// Hash index over bitmap_characters[], built once by BitmapLookup_Init()
+// Each 5x7 bitmap packs into a 35-bit key (5 bits per row). Open addressing with linear probing,
+// slot holds the bitmap_characters[] index + 1, 0 = empty. 256 slots keeps the load factor below 0.5 for ~114 entries.
+#define BITMAP_HASH_SIZE 256
+static uint8_t bitmapHash[BITMAP_HASH_SIZE];
+
+
+// Pack the 7 rows into a 35-bit key. Returns false if any row has bits above the 5 pixel columns (can never match).
+static _Bool PackBitmapKey(const uint8_t* bitmap, uint64_t* key) {
+	uint64_t k = 0;
+	for (int row = 0; row < FONT_HEIGHT; row++) {
+		if (bitmap[row] & 0xE0) return false;
+		k |= (uint64_t)bitmap[row] << (row * 5);
+	}
+	*key = k;
+	return true;
+}
+
+
+static uint8_t BitmapHashSlot(uint64_t key) {
+	// Fold to 32 bits then Fibonacci hash, top 8 bits select the slot
+	uint32_t k = (uint32_t)key ^ (uint32_t)(key >> 32);
+	return (uint8_t)((k * 0x9E3779B1u) >> 24);
+}
+
+
+// Build the hash index from bitmap_characters[]. Must run before the first BitmapToChar().
+// Where bitmap_characters[] holds the same bitmap more than once (i.e. blanks for ' ', '[', ']') the first entry wins, same as the old linear scan.
+void BitmapLookup_Init(void) {
+	memset(bitmapHash, 0, sizeof(bitmapHash));
+
+	for (uint32_t i = 0; i < BITMAP_CHAR_COUNT; i++) {
+		uint64_t key;
+		if (!PackBitmapKey(bitmap_characters[i].bitmap, &key)) continue;
+
+		uint8_t slot = BitmapHashSlot(key);
+		while (bitmapHash[slot] != 0) {
+			if (memcmp(bitmap_characters[bitmapHash[slot] - 1].bitmap, bitmap_characters[i].bitmap, FONT_HEIGHT) == 0) break;  // Duplicate, keep the first
+			slot = (slot + 1) & (BITMAP_HASH_SIZE - 1);
+		}
+		if (bitmapHash[slot] == 0) {
+			bitmapHash[slot] = (uint8_t)(i + 1);
+		}
+	}
+}
+
+
 // Convert a 5x7 bitmap to an ASCII character
-// The bitmap (7 rows of 5 bits each) is compared row by row against the font_data.
-// The comparison involves the 7 rows of the bitmap against the corresponding 7 rows in each font_data entry.
+// The bitmap (7 rows of 5 bits each) is packed into a 35-bit key and looked up in the hash index built by BitmapLookup_Init(),
+// a hit is confirmed with a single compare of the 7 rows against the bitmap_characters[] entry.
 char BitmapToChar(const uint8_t* bitmap) {
-	// Iterate over the bitmap_characters array
-	for (int i = 0; i < sizeof(bitmap_characters) / sizeof(BitmapChar); i++) {
-		// Compare the input bitmap with the current character's bitmap
-		if (memcmp(bitmap, bitmap_characters[i].bitmap, FONT_HEIGHT) == 0) {
-			return bitmap_characters[i].ascii; // Return the matching ASCII character
+	uint64_t key;
+	if (PackBitmapKey(bitmap, &key)) {
+		uint8_t slot = BitmapHashSlot(key);
+		while (bitmapHash[slot] != 0) {
+			const BitmapChar* entry = &bitmap_characters[bitmapHash[slot] - 1];
+			if (memcmp(bitmap, entry->bitmap, FONT_HEIGHT) == 0) {
+				return entry->ascii; // Return the matching ASCII character
+			}
+			slot = (slot + 1) & (BITMAP_HASH_SIZE - 1);
 		}
 	}
 
@@ -331,6 +434,8 @@ char BitmapToChar(const uint8_t* bitmap) {
 // 0 0 0 S31 S32 S33 S34 S35
 //
 void Packets_to_chars(void) {
+	const uint8_t* rx_buffer = VFD_CaptureFrame();	// Complete frame owned by the main loop, the DMA never writes to it
+
 	for (int i = 0; i < PACKET_COUNT; i++) {
 		uint8_t d0 = rx_buffer[i * PACKET_WIDTH + 0];
 		uint8_t d1 = rx_buffer[i * PACKET_WIDTH + 1];
@@ -338,13 +443,14 @@ void Packets_to_chars(void) {
 		uint8_t d3 = rx_buffer[i * PACKET_WIDTH + 3];
 		uint8_t d4 = rx_buffer[i * PACKET_WIDTH + 4];
 
-		chars[Reorder[i]][0] = 0x1F & InverseByte((d1 << 4) | ((d2 & 0x80) >> 4));
-		chars[Reorder[i]][1] = 0x1F & InverseByte((d0 << 7) | ((d1 & 0xF0) >> 1));
-		chars[Reorder[i]][2] = 0x1F & InverseByte((d0 & 0xFE) << 2);
-		chars[Reorder[i]][3] = 0x1F & InverseByte(((d0 & 0xC0) >> 3) | (d4 << 5));
-		chars[Reorder[i]][4] = 0x1F & InverseByte(d4 & 0xF8);
-		chars[Reorder[i]][5] = 0x1F & InverseByte(d3 << 3);
-		chars[Reorder[i]][6] = 0x1F & InverseByte((d2 << 6) | ((d3 & 0xE0) >> 2));
+		uint8_t* row = chars[Reorder[i]];
+		row[0] = RowReverse[(uint8_t)((d1 << 4) | ((d2 & 0x80) >> 4))];
+		row[1] = RowReverse[(uint8_t)((d0 << 7) | ((d1 & 0xF0) >> 1))];
+		row[2] = RowReverse[(uint8_t)((d0 & 0xFE) << 2)];
+		row[3] = RowReverse[(uint8_t)(((d0 & 0xC0) >> 3) | (d4 << 5))];
+		row[4] = RowReverse[(uint8_t)(d4 & 0xF8)];
+		row[5] = RowReverse[(uint8_t)(d3 << 3)];
+		row[6] = RowReverse[(uint8_t)((d2 << 6) | ((d3 & 0xE0) >> 2))];
 		flags[Reorder[i]] = (d2 & 0x40) == 0x40;
 
 		// Update annunciator boolean array for MAIN annunciators (G1 to G18)
@@ -469,25 +575,97 @@ void Main_Aux_R6581(void) {
 }
 
 
+//******************************************************************************
+
+// One render tick, recorded into a display list: the splash every pass, the VFD content as well when 'rendered',
+// then the page flip. Returns once the list has been handed to the DMA, it is sent in the background.
+// Also run by the host simulator in Tools/sim.
+void RenderPass(_Bool rendered) {
+	LT_DisplayListBegin();		// Record this frame's LT7680 writes, DMA sends them in the background from LT_DisplayListEnd()
+
+	uint32_t t = PROFILE_START();
+	DisplaySplash();			// Every pass, it times itself
+	PROFILE_STOP(PROF_SPLASH, t);
+
+	LT_WaitIdle(); // Let the LT7680 finish before the next stage
+
+	// The rest only when the VFD content has changed, or for the periodic refresh
+	if (rendered) {
+		t = PROFILE_START();
+		DisplayMain();
+		PROFILE_STOP(PROF_DISPLAY_MAIN, t);
+
+		LT_WaitIdle(); // Let the LT7680 finish before the next stage
+
+		t = PROFILE_START();
+		DisplayAux();
+		PROFILE_STOP(PROF_DISPLAY_AUX, t);
+
+		LT_WaitIdle(); // Let the LT7680 finish before the next stage
+
+		t = PROFILE_START();
+		DisplayAnnunciators();
+		PROFILE_STOP(PROF_ANNUNCIATORS, t);
+
+		LT_WaitIdle(); // Let the LT7680 finish before the next stage
+
+		// Right wipe
+		t = PROFILE_START();
+		FillRect(0, 952, 399, 959, 0x00, 0x00, 0x00);	// far right hand 8 vertical lines, black, one rectangle (959 and 958 hidden!)
+		LT_PageDirty(0, 952, LCD_XSIZE_TFT, 8);
+		PROFILE_STOP(PROF_RIGHT_WIPE, t);
+
+		// Test only - 400pixel based test lines for viewing the centre line and the left, middle and far right positions.
+		// The internal memory is set up as 400x960 but the leftmost 80 pixels are considered overscan and don't show up, thus 320
+		//DrawLine(0, 0, 399, 0, 0xFF, 0xFF, 0xFF);		// far left hand vertical line, black, 1 pixel line. 938 not 960 seems to be far right edge!
+		//DrawLine(0, 480, 399, 480, 0xFF, 0xFF, 0xFF);	// mid-way
+		//DrawLine(0, 959, 399, 959, 0xFF, 0xFF, 0xFF);	// far right
+		//DrawLine(199, 0, 199, 959, 0xFF, 0x00, 0x00);	// centred on R6581T horizontally
+
+		LT_WaitIdle(); // Let the LT7680 finish before the next stage
+	}
+
+	LT_PageFlip();				// Show what was drawn at the next vertical blank, then sync the other page
+
+	LT_DisplayListEnd();		// Send the list, returns straight away
+}
+
+
 //************************************************************************************************************************************************************
 //************************************************************************************************************************************************************
 
 // Main
 int main(void) {
 
+	Boot_Init();					// DWT cycle counter for the boot timeline in 'bootLog'
+	uint32_t bt = BOOT_START();
+
 	// Reset of all peripherals, Initializes the Flash interface and the Systick.
 	HAL_Init();
+	Boot_Record(BOOT_HAL_INIT, bt);
 
 	// Configure the system clock
+	bt = BOOT_START();
 	SystemClock_Config();
+	Boot_Record(BOOT_CLOCK, bt);
 
 	// Initialize all configured peripherals (except bit-bang SPI for S7701S LCD glass)
+	bt = BOOT_START();
 	MX_GPIO_Init();					// I/O pins
-	MX_DMA_Init();					// DMA1 Ch.2 & Ch.4
+	MX_DMA_Init();					// DMA1 Ch.2, Ch.3 & Ch.4
+	LT_DisplayListInit();			// TIM3 poll interval timer for the display list
 	MX_SPI1_Init();					// SPI1 - LT760A-R
 	MX_SPI2_Init();					// SPI2 - VFD
 	TIM2_Init();					// Initialize the timer
 
+	BitmapLookup_Init();			// Build the VFD glyph hash index used by BitmapToChar()
+	VFD_CaptureInit();				// Hardware CRC unit for the repeated-frame gate
+	Profile_Init();					// DWT cycle counter for the stage timings in 'profile'
+#if VFD_RECORD_ENABLE
+	VFD_RecordInit();				// USART2 TX DMA frame recorder
+#endif
+	Boot_Record(BOOT_PERIPHERALS, bt);
+
 	// Pull CS high and SCLK low immediately after reset
 	HAL_GPIO_WritePin(LCD_CS_Port, LCD_CS_Pin, GPIO_PIN_SET);			// Pull CS high
 	HAL_GPIO_WritePin(LCD_SCK_Port, LCD_SCK_Pin, GPIO_PIN_RESET);		// CLK pin low
@@ -518,21 +696,32 @@ int main(void) {
 		HAL_GPIO_TogglePin(GPIOC, TEST_OUT_Pin); // Test LED toggle
 	}
 		
-	HardwareReset();				// Reset LT7680 - Pull LCM_RESET low for 100ms and wait
+	bt = BOOT_START();
+	HardwareReset();				// Reset LT7680 - Pull LCM_RESET low and wait until it reports ready
+	Boot_Record(BOOT_LT_RESET, bt);
 
-	HAL_Delay(1000);
-	
+	bt = BOOT_START();
 	SendAllToLT7680_LT();			// run subs to setup LT7680 based on Levetop info
 
-	HAL_Delay(10);
+	// SPI1 clock for the LT7680: re-verify the one saved last time, or tune it with a step of margin
+	setting_SPI1_PRESCALER = LT_SpiAutoTune(EEPROM_ReadData(EEPROM_START_ADDRESS + 32));
+	LT_TextFifoLearnDepth();		// Again at the tuned clock, bursts fill the FIFO faster than at the safe one
+	ClearScreen();					// Wipes the learning characters
+	Boot_Record(BOOT_LT_SETUP, bt);
+#if LT_SPI_BENCH_ENABLE
+	LT_SpiBenchmark();				// Cycles per SPI1 frame, register level against HAL, in 'ltSpiBench'
+#endif
 
 	// Main loop timer
 	SetTimerDuration(35);			// 35 ms timed action set
 
-	HAL_Delay(5);
 	ConfigurePWMAndSetBrightness(BACKLIGHTFULL);  // Configure Timer-1 and PWM-1 for backlighting. Settable 0-100%
 
+	bt = BOOT_START();
 	ClearScreen();					// Again.....
+	Boot_Record(BOOT_CLEAR, bt);
+	DisplayInvalidate();			// Nothing left on screen, the first render draws every cell
+	DisplayAtlasInit();				// Pre-render the MAIN, AUX & annunciator glyphs off-screen for BTE copies
 
 	// Read pin A12 - Enter timing changes on boot if DCV button held in during power up
 	GPIO_PinState pinA12 = HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_12);
@@ -542,6 +731,12 @@ int main(void) {
 		timingModsOnBoot = false;
 	}
 
+	// Double buffered rendering, except in timing adjust mode which draws straight onto the screen
+	if (!timingModsOnBoot) {
+		LT_PageInit();
+		DisplayInvalidate();		// Both pages start from the same cleared screen
+	}
+
 
 	// test eeprom (flash)
 	//EEPROM_ErasePage(EEPROM_START_ADDRESS) == HAL_OK;
@@ -552,6 +747,7 @@ int main(void) {
 	//EEPROM_Write4CharString(EEPROM_START_ADDRESS + 28, "AdaF");
 
 	// Load settings from EEProm (Flash)
+	bt = BOOT_START();
 	setting_LCD_VBPD = EEPROM_ReadData(EEPROM_START_ADDRESS);
 	setting_LCD_VFPD = EEPROM_ReadData(EEPROM_START_ADDRESS + 4);
 	setting_LCD_VSPW = EEPROM_ReadData(EEPROM_START_ADDRESS + 8);
@@ -585,18 +781,18 @@ int main(void) {
 		setting_REFRESH_RATE = REFRESH_RATE;
 		strcpy(setting_ADA_BUY, ADA_BUY);
 
-		EEPROM_ErasePage(EEPROM_START_ADDRESS) == HAL_OK;
-	
-		EEPROM_WriteData(EEPROM_START_ADDRESS, setting_LCD_VBPD);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 4, setting_LCD_VFPD);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 8, setting_LCD_VSPW);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 12, setting_LCD_HBPD);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 16, setting_LCD_HFPD);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 20, setting_LCD_HSPW);
-		EEPROM_WriteData(EEPROM_START_ADDRESS + 24, setting_REFRESH_RATE);
-		EEPROM_Write4CharString(EEPROM_START_ADDRESS + 28, setting_ADA_BUY);
+		EEPROM_SaveSettings();
 	
 	}
+	else if (EEPROM_ReadData(EEPROM_START_ADDRESS + 32) != setting_SPI1_PRESCALER) {
+		// New SPI1 clock from the auto-tune. A blank word can be written as it is, otherwise rewrite the page.
+		if (EEPROM_ReadData(EEPROM_START_ADDRESS + 32) == 0xFFFFFFFF) {
+			EEPROM_WriteData(EEPROM_START_ADDRESS + 32, setting_SPI1_PRESCALER);
+		}
+		else {
+			EEPROM_SaveSettings();
+		}
+	}
 
 	// Populate the final vars to be used
 	LCD_VBPD = setting_LCD_VBPD;
@@ -607,18 +803,15 @@ int main(void) {
 	LCD_HSPW = setting_LCD_HSPW;
 	REFRESH_RATE = setting_REFRESH_RATE;
 	strcpy(ADA_BUY, setting_ADA_BUY);
+	Boot_Record(BOOT_EEPROM, bt);
 
 	// ST7701S critical setting
-	if (strcmp(ADA_BUY, "AdaF") == 0) {
-		AdaFruit_Init(); // Initialize AdaFruit driver
-	}
-	else if (strcmp(ADA_BUY, "BuyD") == 0) {
-		BuyDisplay_Init(); // Initialize BuyDisplay driver
-	}
-	else {
+	bt = BOOT_START();
+	if (!LCD_Init(ADA_BUY)) {
 		strcpy(ADA_BUY, "AdaF");
-		AdaFruit_Init(); // Default - Initialize AdaFruit driver
+		LCD_Init(ADA_BUY); // Default - Initialize AdaFruit driver
 	}
+	Boot_Record(BOOT_LCD_INIT, bt);	// Includes the 120 ms sleep out wait
 
 	// TEST sending LT7680 setup info after ST7701S setup
 	//SendAllToLT7680_LT_2();			// run subs to setup LT7680 based on Levetop info
@@ -628,6 +821,12 @@ int main(void) {
 //**************************************************************************************************
 // Main loop initialize
 
+	DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;	// Keep the debugger (LIVE WATCH) working while the main loop sleeps in __WFI()
+
+	uint32_t framesTick = HAL_GetTick();
+	uint32_t framesDecodedLast = 0;
+	uint32_t framesCapturedLast = 0;
+
 	Init_Completed_flag = 1; // Now is a safe time to enable the EXTI interrupt handler
 
 	while (1) {
@@ -636,14 +835,57 @@ int main(void) {
 		//char inputString[] = "123.456";
 		//test15 = atof(inputString);
 
-		Packets_to_chars();         // Convert packets from R6581 to characters
-		Main_Aux_R6581();           // Get R6581 VFD drive data
+		// Decode only when the SPI2 RX DMA has delivered a new frame. Events that queued up while the LCD was being
+		// drawn are taken together and only the newest frame is decoded, older ones are already stale.
+		VFD_CaptureReplayPoll();    // Recorded frame from the host, when in replay mode
+
+		uint32_t frameSeq;
+		_Bool newFrame = (framesDecoded == 0);	// First pass decodes the empty buffer, as before, so G[] is valid from the start
+		while (VFD_FrameQueuePop(&frameSeq)) {
+			newFrame = true;
+		}
+
+		if (newFrame) {
+#if VFD_RECORD_ENABLE
+			_Bool acquired = VFD_CaptureAcquire();	// Take the newest complete VFD frame
+#else
+			VFD_CaptureAcquire();					// Take the newest complete VFD frame
+#endif
+
+			// Hardware CRC gate, a frame identical to the last one needs no decode and no render
+			_Bool changed = VFD_CaptureChanged();
+
+#if VFD_RECORD_ENABLE
+			if (acquired) VFD_RecordFrame(VFD_CaptureFrame(), vfdDecodeSeq, changed);	// Stream it out of USART2
+#endif
+
+			if (changed || framesDecoded == 0) {
+				uint32_t t = PROFILE_START();
+				Packets_to_chars();         // Convert packets from R6581 to characters
+				PROFILE_STOP(PROF_PACKETS_TO_CHARS, t);
+
+				t = PROFILE_START();
+				Main_Aux_R6581();           // Get R6581 VFD drive data
+				PROFILE_STOP(PROF_MAIN_AUX, t);
+				framesDecoded++;
+				if (!renderPending) renderPendingSince = vfdDecodeCapturedAt;	// Oldest change not yet on screen
+				renderPending = true;
+			}
+		}
 
 		task_ready = 1; // Mark tasks as complete so the timer driven code is allowed to run again
 
 		//*******************************************************************************************
-		// Timed Action - Check if timer flag is set and tasks are ready and run the LCD sub
-		if (timer_flag && task_ready) {
+		// Render scheduling. TIM2 still ticks every 35 ms for the housekeeping (splash, front panel buttons).
+		// A changed frame is rendered straight away rather than on the next tick, but no sooner than
+		// renderMinIntervalMs after the last render, and the screen is refreshed anyway after renderMaxIdleMs.
+		uint32_t now = HAL_GetTick();
+		_Bool renderDue = !timingModsOnBoot && renderPending && (now - lastRenderTick >= renderMinIntervalMs);
+		_Bool refreshDue = !timingModsOnBoot && (now - lastRenderTick >= renderMaxIdleMs);
+
+		//*******************************************************************************************
+		// Timed Action - Check if timer flag is set (or a render is due) and tasks are ready and run the LCD sub
+		if ((timer_flag || renderDue || refreshDue) && task_ready) {
 			timer_flag = 0;   // Clear the timer flag
 			task_ready = 0;   // Reset task-ready flag    
 			
@@ -651,40 +893,26 @@ int main(void) {
 
 				HAL_GPIO_TogglePin(GPIOC, TEST_OUT_Pin); // Test LED toggle
 
-				DisplaySplash();
-
-				HAL_Delay(6); // Allow the LT7680 sufficient processing time
-
-				DisplayMain();
-
-				HAL_Delay(6); // Allow the LT7680 sufficient processing time
-
-				DisplayAux();
-
-				HAL_Delay(6); // Allow the LT7680 sufficient processing time
-
-				DisplayAnnunciators();
-
-				HAL_Delay(6); // Allow the LT7680 sufficient processing time
-
-				// Right wipe
-				DrawLine(0, 959, 399, 959, 0x00, 0x00, 0x00);	// far right hand vertical line, black, 1 pixel line. (this line hidden!)
-				DrawLine(0, 958, 399, 958, 0x00, 0x00, 0x00);	// (this line hidden!)
-				DrawLine(0, 957, 399, 957, 0x00, 0x00, 0x00);
-				DrawLine(0, 956, 399, 956, 0x00, 0x00, 0x00);
-				DrawLine(0, 955, 399, 955, 0x00, 0x00, 0x00);
-				DrawLine(0, 954, 399, 954, 0x00, 0x00, 0x00);
-				DrawLine(0, 953, 399, 953, 0x00, 0x00, 0x00);
-				DrawLine(0, 952, 399, 952, 0x00, 0x00, 0x00);
-
-				// Test only - 400pixel based test lines for viewing the centre line and the left, middle and far right positions.
-				// The internal memory is set up as 400x960 but the leftmost 80 pixels are considered overscan and don't show up, thus 320
-				//DrawLine(0, 0, 399, 0, 0xFF, 0xFF, 0xFF);		// far left hand vertical line, black, 1 pixel line. 938 not 960 seems to be far right edge!
-				//DrawLine(0, 480, 399, 480, 0xFF, 0xFF, 0xFF);	// mid-way
-				//DrawLine(0, 959, 399, 959, 0xFF, 0xFF, 0xFF);	// far right
-				//DrawLine(199, 0, 199, 959, 0xFF, 0x00, 0x00);	// centred on R6581T horizontally
+				// SPI cost of the previous render tick, including the part of its display list sent in the background
+				renderSpiBytes = ltSpiBytes - renderSpiBytesLast;
+				renderSpiTransactions = ltSpiTransactions - renderSpiTransactionsLast;
+				renderSpiBytesLast = ltSpiBytes;
+				renderSpiTransactionsLast = ltSpiTransactions;
+
+				// The VFD content only when it has changed, or for the periodic refresh
+				_Bool rendered = renderDue || refreshDue;
+				if (rendered) {
+					renderPending = false;
+					lastRenderTick = now;
+				}
+				RenderPass(rendered);		// Returns straight away so the next VFD frame can be decoded while the SPI bus drains
 
-				HAL_Delay(6); // Allow the LT7680 sufficient processing time
+				// Capture-to-render latency: from the oldest unrendered change being captured to its render list going out
+				if (renderDue) {
+					renderLatencyUs = (DWT->CYCCNT - renderPendingSince) / (SystemCoreClock / 1000000);
+					if (renderLatencyUs > renderLatencyMaxUs) renderLatencyMaxUs = renderLatencyUs;
+					renderLatencyMeanUs = renderLatencyMeanUs - (renderLatencyMeanUs >> 4) + (renderLatencyUs >> 4);
+				}
 
 				// Read pins A11/A12 - Front panel DCV switch momentary - Enable 1VDC mode
 				GPIO_PinState pinA11 = HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_11);
@@ -700,6 +928,8 @@ int main(void) {
 					if (!oneVoltmodepreviousState) {
 						// Toggle the mode on the first detection of the press
 						oneVoltmode = !oneVoltmode;
+						if (!renderPending) renderPendingSince = DWT->CYCCNT;
+						renderPending = true;		// AUX text changes without the VFD frame changing
 					}
 					// Update the previous state
 					oneVoltmodepreviousState = true;
@@ -748,7 +978,7 @@ int main(void) {
 							strcpy(ADA_BUY, setting_ADA_BUY);
 
 							// run startup subs again to apply new settings
-							AdaFruit_Init();
+							LCD_Init(ADA_BUY);
 							HAL_Delay(5);
 							LT7680_PLL_Initial_LT();
 							HAL_Delay(5);
@@ -764,18 +994,10 @@ int main(void) {
 							HAL_Delay(5);
 							LCD_VSYNC_Pulse_Width_LT(LCD_VSPW);       // VSYNC Pulse Width
 							HAL_Delay(5);
-
-							EEPROM_ErasePage(EEPROM_START_ADDRESS) == HAL_OK;		// Erase Flash
+							DisplayInvalidate();                      // Panel re-initialised, redraw every cell
 
 							// Save the updated settings to flash
-							EEPROM_WriteData(EEPROM_START_ADDRESS, setting_LCD_VBPD);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 4, setting_LCD_VFPD);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 8, setting_LCD_VSPW);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 12, setting_LCD_HBPD);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 16, setting_LCD_HFPD);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 20, setting_LCD_HSPW);
-							EEPROM_WriteData(EEPROM_START_ADDRESS + 24, setting_REFRESH_RATE);
-							EEPROM_Write4CharString(EEPROM_START_ADDRESS + 28, setting_ADA_BUY);
+							EEPROM_SaveSettings();
 						}
 
 						HAL_Delay(6);
@@ -933,6 +1155,25 @@ int main(void) {
 			
 
 		}
+
+		//*******************************************************************************************
+		// Frames per second, once a second (LIVE WATCH)
+		if (HAL_GetTick() - framesTick >= 1000) {
+			framesTick += 1000;
+			framesDecodedPerSecond = framesDecoded - framesDecodedLast;
+			framesCapturedPerSecond = vfdFrameSeq - framesCapturedLast;
+			framesDecodedLast = framesDecoded;
+			framesCapturedLast = vfdFrameSeq;
+		}
+
+		//*******************************************************************************************
+		// Nothing to do until the next VFD frame or timer tick, sleep. Interrupts are masked around the test so one
+		// arriving in between still wakes __WFI() (it wakes on a pending interrupt even when masked).
+		__disable_irq();
+		if (VFD_FrameQueueEmpty() && !timer_flag) {
+			__WFI();
+		}
+		__enable_irq();
 	}
 
 }
@@ -992,6 +1233,22 @@ void EEPROM_Read4CharString(uint32_t address, char* buffer) {
 
 
 
+// Erase the settings page and write all the setting_ vars back
+void EEPROM_SaveSettings(void) {
+	EEPROM_ErasePage(EEPROM_START_ADDRESS);
+
+	EEPROM_WriteData(EEPROM_START_ADDRESS, setting_LCD_VBPD);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 4, setting_LCD_VFPD);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 8, setting_LCD_VSPW);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 12, setting_LCD_HBPD);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 16, setting_LCD_HFPD);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 20, setting_LCD_HSPW);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 24, setting_REFRESH_RATE);
+	EEPROM_Write4CharString(EEPROM_START_ADDRESS + 28, setting_ADA_BUY);
+	EEPROM_WriteData(EEPROM_START_ADDRESS + 32, setting_SPI1_PRESCALER);	// SPI1 BR bits, from LT_SpiAutoTune()
+}
+
+
 // Erase EEprom (Flash) - necessary before write
 HAL_StatusTypeDef EEPROM_ErasePage(uint32_t address) {
 	if (address < EEPROM_START_ADDRESS || address >= (EEPROM_START_ADDRESS + EEPROM_PAGE_SIZE)) {
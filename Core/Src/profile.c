@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    profile.c
+  * @brief   This file provides code for timing the VFD decode and
+  *          LCD render stages with the Cortex-M3 DWT cycle counter.
+  ******************************************************************************
+*/
+
+// Each stage keeps count, last, min, max, a rolling mean and a log2 histogram of its run time in CPU cycles
+// (72 cycles = 1 us). Everything is in the one 'profile' struct so a debugger LIVE WATCH, or a host script
+// reading it over SWD, sees the whole picture. The render stages record into a display list, so their times are
+// CPU time only, the SPI transfer happens afterwards in the background.
+//
+// Each stage is only ever recorded from one context (EXTI from its interrupt, the rest from the main loop),
+// so no locking is needed.
+//
+// The boot log times each phase of main()'s start-up, also with the cycle counter. Boot_Init() starts the counter
+// before HAL_Init(), when the core still runs from the 8 MHz HSI, so cycles are turned into microseconds at the
+// clock speed each phase started with.
+
+#include "profile.h"
+
+volatile ProfileData profile;
+BootLog bootLog;
+
+static uint32_t bootHz;						// SystemCoreClock as of the last boot record
+static uint32_t bootLast;					// Cycle count of the last boot record
+static uint32_t bootUs;						// Time since reset at bootLast
+
+
+// Start the DWT cycle counter for the boot log, first thing in main()
+void Boot_Init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;		// Enable the DWT block
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	bootHz = SystemCoreClock;
+	bootLast = 0;
+	bootUs = 0;
+}
+
+
+// A boot phase that started at cycle count 'start' has just finished. Only SystemClock_Config() changes the
+// clock, and it starts and ends on a record, so bootHz is always the speed the phase started at.
+void Boot_Record(BootPhaseId id, uint32_t start) {
+	uint32_t now = DWT->CYCCNT;
+	uint32_t mhz = bootHz / 1000000;
+
+	bootLog.us[id] = (now - start) / mhz;
+	bootUs += (now - bootLast) / mhz;
+	bootLog.at[id] = bootUs;
+
+	bootLast = now;
+	bootHz = SystemCoreClock;
+}
+
+
+// Start the DWT cycle counter, if Boot_Init() has not already
+void Profile_Init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;		// Enable the DWT block
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	Profile_Reset();
+}
+
+
+// Clear all statistics, e.g. from the debugger after changing something
+void Profile_Reset(void) {
+	for (int i = 0; i < PROF_STAGES; i++) {
+		volatile ProfileStage* s = &profile.stage[i];
+		s->count = 0;
+		s->last = 0;
+		s->min = UINT32_MAX;
+		s->max = 0;
+		s->mean = 0;
+		s->total = 0;
+		for (int b = 0; b < PROFILE_HIST_BINS; b++) s->hist[b] = 0;
+	}
+	profile.coreHz = SystemCoreClock;
+}
+
+
+void Profile_Record(ProfileStageId id, uint32_t cycles) {
+	volatile ProfileStage* s = &profile.stage[id];
+
+	s->last = cycles;
+	if (cycles < s->min) s->min = cycles;
+	if (cycles > s->max) s->max = cycles;
+	s->mean = (s->count == 0) ? cycles : s->mean - (s->mean >> 4) + (cycles >> 4);
+	s->total += cycles;
+	s->count++;
+
+	// log2 bin: index of the highest set bit
+	uint32_t bin = (cycles == 0) ? 0 : 31 - __CLZ(cycles);
+	if (bin >= PROFILE_HIST_BINS) bin = PROFILE_HIST_BINS - 1;
+	if (s->hist[bin] != UINT16_MAX) s->hist[bin]++;
+}
@@ -34,6 +34,7 @@ void MX_SPI1_Init(void)                                     // LCD (LT7680)
     {
         Error_Handler();
     }
+    __HAL_SPI_ENABLE(&hspi1);                               // The LT7680 transfers are register level, HAL no longer turns it on
 }
 
 /* SPI2 init function */
@@ -22,6 +22,9 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "displaylist.h"
+#include "vfdcapture.h"
+#include "profile.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -41,7 +44,6 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
-extern uint8_t rx_buffer[PACKET_WIDTH*PACKET_COUNT];
 extern uint8_t Init_Completed_flag;
 /* USER CODE END PV */
 
@@ -190,6 +192,7 @@ void SysTick_Handler(void)
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
+  LT_DisplayListTick();                 // Resume a display list paused by LT_Delay()
 
   /* USER CODE END SysTick_IRQn 1 */
 }
@@ -201,6 +204,20 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32f1xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles DMA1 channel2 global interrupt.
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 0 */
+
+  /* USER CODE END DMA1_Channel2_IRQn 0 */
+  LT_DisplayListIRQHandler();           // SPI1 RX DMA, end of each display list frame (displaylist.c)
+  /* USER CODE BEGIN DMA1_Channel2_IRQn 1 */
+
+  /* USER CODE END DMA1_Channel2_IRQn 1 */
+}
+
 /**
   * @brief This function handles DMA1 channel3 global interrupt.
   */
@@ -209,7 +226,7 @@ void DMA1_Channel3_IRQHandler(void)
   /* USER CODE BEGIN DMA1_Channel3_IRQn 0 */
 
   /* USER CODE END DMA1_Channel3_IRQn 0 */
-  HAL_DMA_IRQHandler(&hdma_spi1_tx);
+  LT_DisplayListIRQHandler();           // SPI1 TX DMA is driven by the display list engine (displaylist.c)
   /* USER CODE BEGIN DMA1_Channel3_IRQn 1 */
 
   /* USER CODE END DMA1_Channel3_IRQn 1 */
@@ -252,17 +269,19 @@ void EXTI15_10_IRQHandler(void)
 // Every 9 ms, during the start of a new display scan cycle, the S-IN56 signal is generated 
 // to load "1" into the chain of shift registers U5-U6. The edge of this signal is used as an 
 // interrupt source, which starts reading 47 packets of 5 bytes each (interrupt frequency ~111 Hz)
-  if (Init_Completed_flag) {
+  uint32_t t = PROFILE_START();
+  if (Init_Completed_flag && !vfdReplayMode) {   // Replay mode feeds recorded frames instead, see vfdcapture.c
       HAL_SPI_DMAStop(&hspi2);              // Used to ensure robustness when failures occur in SPI transfers.
       HAL_SPI_Abort(&hspi2);                // ---- "" ----
       __HAL_RCC_SPI2_FORCE_RESET();         // ---- "" ----
       __HAL_RCC_SPI2_RELEASE_RESET();       // ---- "" ----
       HAL_SPI_Init(&hspi2);                 // ---- "" ----
-      HAL_SPI_Receive_DMA (&hspi2, rx_buffer, PACKET_WIDTH*PACKET_COUNT);
+      HAL_SPI_Receive_DMA (&hspi2, VFD_CaptureStart(), PACKET_WIDTH*PACKET_COUNT);   // Published by HAL_SPI_RxCpltCallback only once complete
   }
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(VFD_RESTART_Pin);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+  PROFILE_STOP(PROF_EXTI, t);
 
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
@@ -0,0 +1,210 @@
+/**
+  ******************************************************************************
+  * @file    vfdcapture.c
+  * @brief   This file provides code for the triple-buffered capture
+  *          of the R6581 VFD frames received by SPI2 DMA.
+  ******************************************************************************
+*/
+
+// Each VFD scan (~111 Hz) the EXTI on S-IN56 restarts the SPI2 RX DMA for 47 packets of 5 bytes. The DMA used to
+// write straight into the one buffer the main loop was decoding, so decode could see half of one frame and half
+// of the next.
+//
+// Three buffers are now rotated, the usual triple-buffer scheme:
+//   back   - being filled by the DMA (owned by the interrupts)
+//   middle - newest complete frame, waiting for the main loop
+//   front  - being decoded by the main loop (owned by the main loop)
+// Only when the DMA has received all 235 bytes is the back buffer swapped with the middle one and a new frame
+// sequence number published. A frame cut short by the next S-IN56 edge is simply overwritten and never seen.
+// The main loop swaps the middle buffer with its front one when a new frame is waiting, so it always decodes a
+// complete frame that nothing else is writing to.
+//
+// The middle index and a 'fresh' flag share one byte, swapped with LDREXB/STREXB. Both sides swap without
+// disabling interrupts: the interrupt always wins, and an interrupt between the main loop's LDREXB and STREXB
+// clears the exclusive monitor so the main loop simply tries again.
+//
+// Replay: with vfdReplayMode set the EXTI stops starting live captures, and frames written into vfdReplayFrame[]
+// by the debugger or a host script (bump vfdReplayRequest after each one) are published exactly as if SPI2 had
+// captured them. The whole decode and render pipeline then runs on recorded frames, e.g. from the frame recorder,
+// and vfdDecodeSeq, G[], Annunc[] and the render counters can be read back per frame.
+//
+// Each published frame also pushes its sequence number onto a single-producer/single-consumer queue, so the main
+// loop only decodes when a frame has actually arrived and can sleep the rest of the time. The interrupt only
+// writes queueHead and the main loop only writes queueTail, so no locking is needed.
+
+#include "vfdcapture.h"
+#include "main.h"
+#include "spi.h"
+#include <string.h>
+
+#define VFD_FRAME_SIZE			(PACKET_WIDTH * PACKET_COUNT)	// 235 bytes
+#define VFD_FRAME_WORDS			((VFD_FRAME_SIZE + 3) / 4)		// Buffers padded to whole words for the CRC unit
+
+#define CAPTURE_FRESH			0x80		// Middle buffer holds a frame the main loop has not taken yet
+#define CAPTURE_INDEX			0x03
+
+static uint8_t captureBuf[VFD_CAPTURE_BUFFERS][VFD_FRAME_WORDS * 4] __attribute__((aligned(4)));	// Pad byte stays 0
+static uint32_t captureSeq[VFD_CAPTURE_BUFFERS];	// Frame sequence number of each buffer
+static uint32_t captureCycles[VFD_CAPTURE_BUFFERS];	// DWT cycle count when each buffer was published
+
+static uint8_t captureBack = 0;				// Interrupts only
+static volatile uint8_t captureMiddle = 1;	// Shared: index | CAPTURE_FRESH
+static uint8_t captureFront = 2;			// Main loop only
+
+static volatile uint32_t queueSeq[VFD_QUEUE_LEN];	// Sequence numbers of published frames
+static volatile uint8_t queueHead = 0;		// Written by the interrupt only
+static volatile uint8_t queueTail = 0;		// Written by the main loop only
+
+uint8_t vfdReplayFrame[VFD_FRAME_SIZE];		// Written by the debugger / host script
+volatile uint8_t vfdReplayMode = 0;			// 1 = live capture off, frames come from vfdReplayFrame[]
+volatile uint32_t vfdReplayRequest = 0;		// Bumped by the host after writing vfdReplayFrame[]
+static uint32_t replayTaken = 0;
+
+volatile uint32_t vfdFrameSeq = 0;
+uint32_t vfdDecodeSeq = 0;
+uint32_t vfdDecodeCapturedAt = 0;
+uint32_t vfdFramesDropped = 0;
+uint32_t vfdQueueOverflows = 0;
+uint32_t vfdCrcHits = 0;
+uint32_t vfdCrcMisses = 0;
+
+static uint32_t lastFrameCRC = 0;
+
+
+// Enable the hardware CRC unit used to spot repeated frames
+void VFD_CaptureInit(void) {
+	RCC->AHBENR |= RCC_AHBENR_CRCEN;
+	(void)RCC->AHBENR;						// Delay after enabling the clock
+}
+
+
+// Atomically replace the middle byte, returns the old value
+static uint8_t CaptureExchange(uint8_t value) {
+	uint8_t old;
+
+	do {
+		old = __LDREXB(&captureMiddle);
+	} while (__STREXB(value, &captureMiddle));
+
+	return old;
+}
+
+
+// Called from EXTI15_10_IRQHandler, returns the buffer the SPI2 RX DMA should fill for this scan
+uint8_t* VFD_CaptureStart(void) {
+	return captureBuf[captureBack];
+}
+
+
+// Called from HAL_SPI_RxCpltCallback once all 235 bytes are in, publishes the back buffer as the newest frame
+void VFD_CapturePublish(void) {
+	captureSeq[captureBack] = vfdFrameSeq + 1;
+	captureCycles[captureBack] = DWT->CYCCNT;
+
+	uint8_t old = CaptureExchange(captureBack | CAPTURE_FRESH);
+	if (old & CAPTURE_FRESH) vfdFramesDropped++;
+	captureBack = old & CAPTURE_INDEX;
+
+	vfdFrameSeq++;
+
+	// Tell the main loop. If it has fallen a whole queue behind, the event is dropped, the frame itself is not:
+	// the main loop always decodes the newest frame.
+	uint8_t next = (queueHead + 1) % VFD_QUEUE_LEN;
+	if (next == queueTail) {
+		vfdQueueOverflows++;
+	}
+	else {
+		queueSeq[queueHead] = vfdFrameSeq;
+		__DMB();							// Entry written before the main loop can see the new head
+		queueHead = next;
+	}
+}
+
+
+// Main loop: take the next frame event off the queue. Returns false if the queue is empty.
+_Bool VFD_FrameQueuePop(uint32_t* seq) {
+	uint8_t tail = queueTail;
+
+	if (tail == queueHead) return false;
+
+	__DMB();								// Head read before the entry
+	*seq = queueSeq[tail];
+	queueTail = (tail + 1) % VFD_QUEUE_LEN;
+	return true;
+}
+
+
+_Bool VFD_FrameQueueEmpty(void) {
+	return queueTail == queueHead;
+}
+
+
+// Main loop: take the newest complete frame if there is one. Returns false if nothing new has arrived,
+// in which case VFD_CaptureFrame() still returns the previous frame.
+_Bool VFD_CaptureAcquire(void) {
+	uint8_t middle;
+
+	do {
+		middle = __LDREXB(&captureMiddle);
+		if (!(middle & CAPTURE_FRESH)) {
+			__CLREX();
+			return false;
+		}
+	} while (__STREXB(captureFront, &captureMiddle));
+
+	captureFront = middle & CAPTURE_INDEX;
+	vfdDecodeSeq = captureSeq[captureFront];
+	vfdDecodeCapturedAt = captureCycles[captureFront];
+	return true;
+}
+
+
+// Frame currently owned by the main loop
+const uint8_t* VFD_CaptureFrame(void) {
+	return captureBuf[captureFront];
+}
+
+
+// CRC-32 (hardware CRC unit, 59 word writes) of the frame owned by the main loop. Returns true if it differs from
+// the last frame checked, so an unchanged frame can skip decode and render altogether.
+_Bool VFD_CaptureChanged(void) {
+	const uint32_t* w = (const uint32_t*)captureBuf[captureFront];
+
+#if LT_HOST_SIM
+	uint32_t crc = SimCrc_Words(w, VFD_FRAME_WORDS);	// Host simulator (Tools/sim), no CRC unit
+#else
+	CRC->CR = CRC_CR_RESET;
+	for (int i = 0; i < VFD_FRAME_WORDS; i++) {
+		CRC->DR = w[i];
+	}
+	uint32_t crc = CRC->DR;
+#endif
+
+	if (crc == lastFrameCRC) {
+		vfdCrcHits++;
+		return false;
+	}
+
+	lastFrameCRC = crc;
+	vfdCrcMisses++;
+	return true;
+}
+
+
+// Main loop: publish vfdReplayFrame[] when replay mode is on and the host has supplied a new frame
+void VFD_CaptureReplayPoll(void) {
+	if (!vfdReplayMode || vfdReplayRequest == replayTaken) return;
+	replayTaken = vfdReplayRequest;
+
+	// Act as the capture interrupts for this one frame. A live scan started before replay mode was set may still
+	// be filling the back buffer, stop it first.
+	HAL_NVIC_DisableIRQ(EXTI15_10_IRQn);
+	HAL_NVIC_DisableIRQ(DMA1_Channel4_IRQn);
+	HAL_SPI_DMAStop(&hspi2);
+
+	memcpy(captureBuf[captureBack], vfdReplayFrame, VFD_FRAME_SIZE);
+	VFD_CapturePublish();
+
+	HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+	HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
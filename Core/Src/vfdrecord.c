@@ -0,0 +1,186 @@
+/**
+  ******************************************************************************
+  * @file    vfdrecord.c
+  * @brief   This file provides code for the raw VFD frame recorder,
+  *          streamed out of USART2 by DMA for building a replay corpus.
+  ******************************************************************************
+*/
+
+// The main loop hands every frame it takes from the capture buffers to VFD_RecordFrame(), together with the
+// result of the CRC check. A changed frame is queued as a FRAME record (244 bytes), an unchanged one only adds to
+// a repeat count that goes out as one small REPEAT record, so a steady reading costs a few bytes a second rather
+// than 27 kB/s.
+//
+// Records are queued in a RAM ring. DMA1 Channel 7 sends the ring to USART2 in the background, a contiguous run
+// at a time, and its transfer-complete interrupt starts the next run. The main loop never waits for the UART:
+// when the ring is full the record is dropped and counted, and the next frame is sent in full.
+//
+// Register level, the HAL UART module is not built into this project. Record layout is in vfdrecord.h, the host
+// side decoder is Tools/vfd_record_decode.py.
+
+#include "vfdrecord.h"
+
+#if VFD_RECORD_ENABLE
+
+#include "main.h"
+
+#define RECORD_HEADER			8			// sync, type, tick (4), seq (2)
+#define RECORD_FRAME_SIZE		(RECORD_HEADER + PACKET_WIDTH * PACKET_COUNT + 1)
+#define RECORD_REPEAT_SIZE		(RECORD_HEADER + 2 + 1)
+
+static uint8_t recRing[VFD_RECORD_RING];
+static volatile uint16_t recHead = 0;		// Written by the main loop only
+static volatile uint16_t recTail = 0;		// Written by the DMA interrupt only
+static volatile uint16_t recTxLen = 0;		// Bytes in the DMA transfer in flight, 0 = idle
+
+static uint16_t repeatCount = 0;			// Unchanged frames not yet written out
+static uint32_t repeatTick = 0;
+static uint32_t repeatSeq = 0;
+static _Bool needFullFrame = true;			// Next frame must be a FRAME record (start, or after a drop)
+
+uint32_t vfdRecordFrames = 0;
+uint32_t vfdRecordRepeats = 0;
+uint32_t vfdRecordDrops = 0;
+
+
+// Enable USART2 TX on PA2 and DMA1 Channel 7
+void VFD_RecordInit(void) {
+	RCC->APB2ENR |= RCC_APB2ENR_IOPAEN;
+	RCC->APB1ENR |= RCC_APB1ENR_USART2EN;
+	(void)RCC->APB1ENR;						// Delay after enabling the clock
+
+	// PA2: alternate function push-pull, 50 MHz
+	GPIOA->CRL = (GPIOA->CRL & ~(GPIO_CRL_MODE2 | GPIO_CRL_CNF2)) | GPIO_CRL_MODE2 | GPIO_CRL_CNF2_1;
+
+	USART2->BRR = (HAL_RCC_GetPCLK1Freq() + VFD_RECORD_BAUD / 2) / VFD_RECORD_BAUD;
+	USART2->CR3 = USART_CR3_DMAT;
+	USART2->CR1 = USART_CR1_UE | USART_CR1_TE;
+
+	// DMA1 Channel 7: memory to USART2->DR, byte wide, memory increment, transfer-complete interrupt
+	DMA1_Channel7->CCR = 0;
+	DMA1_Channel7->CPAR = (uint32_t)&USART2->DR;
+	DMA1_Channel7->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE;
+
+	HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 2, 0);		// Below the VFD capture and the display list
+	HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+}
+
+
+// Start sending the next contiguous run of the ring, if the DMA is idle and there is anything to send
+static void RecordKick(void) {
+	if (recTxLen != 0) return;
+
+	uint16_t head = recHead;
+	uint16_t tail = recTail;
+	if (head == tail) return;
+
+	uint16_t len = (head > tail) ? (head - tail) : (VFD_RECORD_RING - tail);
+	recTxLen = len;
+
+	DMA1_Channel7->CCR &= ~DMA_CCR_EN;
+	DMA1_Channel7->CMAR = (uint32_t)&recRing[tail];
+	DMA1_Channel7->CNDTR = len;
+	DMA1_Channel7->CCR |= DMA_CCR_EN;
+}
+
+
+void DMA1_Channel7_IRQHandler(void) {
+	if (DMA1->ISR & DMA_ISR_TCIF7) {
+		DMA1->IFCR = DMA_IFCR_CGIF7;
+		recTail = (recTail + recTxLen) % VFD_RECORD_RING;
+		recTxLen = 0;
+		RecordKick();
+	}
+}
+
+
+static uint16_t RecordFree(void) {
+	return (uint16_t)((recTail + VFD_RECORD_RING - recHead - 1) % VFD_RECORD_RING);
+}
+
+
+// Append bytes to the ring, updating the running XOR check. Space has already been checked.
+static void RecordPut(const uint8_t* data, uint16_t len, uint8_t* check) {
+	uint16_t head = recHead;
+
+	for (uint16_t i = 0; i < len; i++) {
+		recRing[head] = data[i];
+		*check ^= data[i];
+		head = (head + 1) % VFD_RECORD_RING;
+	}
+	recHead = head;
+}
+
+
+static void RecordHeader(uint8_t type, uint32_t tick, uint32_t seq, uint8_t* check) {
+	uint8_t header[RECORD_HEADER] = {
+		VFD_RECORD_SYNC, type,
+		(uint8_t)tick, (uint8_t)(tick >> 8), (uint8_t)(tick >> 16), (uint8_t)(tick >> 24),
+		(uint8_t)seq, (uint8_t)(seq >> 8)
+	};
+
+	RecordPut(header, 1, check);
+	*check = 0;								// The check covers everything after the sync byte
+	RecordPut(&header[1], RECORD_HEADER - 1, check);
+}
+
+
+static void RecordClose(uint8_t check) {
+	uint8_t unused = 0;
+	RecordPut(&check, 1, &unused);
+
+	// The DMA interrupt also calls RecordKick(), keep it out while the main loop does
+	NVIC_DisableIRQ(DMA1_Channel7_IRQn);
+	RecordKick();
+	NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+}
+
+
+static void RecordRepeatFlush(void) {
+	if (repeatCount == 0) return;
+
+	if (RecordFree() < RECORD_REPEAT_SIZE) {
+		vfdRecordDrops++;
+		needFullFrame = true;
+	}
+	else {
+		uint8_t check = 0;
+		uint8_t count[2] = { (uint8_t)repeatCount, (uint8_t)(repeatCount >> 8) };
+		RecordHeader(VFD_RECORD_REPEAT, repeatTick, repeatSeq, &check);
+		RecordPut(count, 2, &check);
+		RecordClose(check);
+		vfdRecordRepeats++;
+	}
+	repeatCount = 0;
+}
+
+
+// Main loop: record one frame taken from the capture buffers. 'changed' is the CRC gate result for it.
+void VFD_RecordFrame(const uint8_t* frame, uint32_t seq, _Bool changed) {
+	uint32_t tick = HAL_GetTick();
+
+	if (!changed && !needFullFrame) {
+		repeatCount++;
+		repeatTick = tick;
+		repeatSeq = seq;
+		if (repeatCount >= VFD_RECORD_RUN_MAX) RecordRepeatFlush();
+		return;
+	}
+
+	RecordRepeatFlush();
+
+	if (RecordFree() < RECORD_FRAME_SIZE) {
+		vfdRecordDrops++;
+		needFullFrame = true;
+		return;
+	}
+
+	uint8_t check = 0;
+	RecordHeader(VFD_RECORD_FRAME, tick, seq, &check);
+	RecordPut(frame, PACKET_WIDTH * PACKET_COUNT, &check);
+	RecordClose(check);
+	vfdRecordFrames++;
+	needFullFrame = false;
+}
+
+#endif // VFD_RECORD_ENABLE
@@ -0,0 +1,162 @@
+/**
+  ******************************************************************************
+  * @file    glyphbench.c
+  * @brief   Host benchmark: BitmapToChar()'s hash lookup against the linear
+  *          memcmp() scan it replaced, on the glyphs of real VFD frames.
+  ******************************************************************************
+*/
+
+// Usage: glyphbench [-n passes] [frames.vfdr ...]
+//
+// The glyphs are the 47 bitmaps of every frame in the recordings, decoded by the firmware's Packets_to_chars()
+// through the replay slot, so the mix of characters (mostly digits, blanks and a few unit letters) is the one the
+// board sees. Without a recording every bitmap_characters[] entry is looked up once per pass, plus a bitmap that
+// is in none of them. Both lookups must return the same character for every glyph, or the run fails.
+//
+// Times are host nanoseconds per lookup and only compare the two methods with each other; the compare count of the
+// linear scan is the figure that carries over to the Cortex-M3, where each memcmp() of 7 bytes is a call.
+
+#include "main.h"
+#include "vfdcapture.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GLYPH_FRAME_SIZE		(PACKET_WIDTH * PACKET_COUNT)
+#define GLYPH_ENTRY_SIZE		(4 + GLYPH_FRAME_SIZE)		// .vfdr: tick (u32) + frame
+
+extern uint8_t chars[CHAR_COUNT][CHAR_HEIGHT];				// Packets_to_chars() output, in main.c
+
+static uint8_t (*glyphs)[CHAR_HEIGHT];
+static uint32_t glyphCount = 0;
+static uint32_t glyphSize = 0;
+
+static uint64_t linearCompares = 0;
+static uint64_t linearMisses = 0;
+
+
+// BitmapToChar() as it was before the hash index, counting its compares
+static char LinearBitmapToChar(const uint8_t* bitmap) {
+	for (uint32_t i = 0; i < bitmapCharCount; i++) {
+		linearCompares++;
+		if (memcmp(bitmap, bitmap_characters[i].bitmap, CHAR_HEIGHT) == 0) {
+			return bitmap_characters[i].ascii;
+		}
+	}
+	linearMisses++;
+	return '?';
+}
+
+
+static void AddGlyph(const uint8_t* bitmap) {
+	if (glyphCount == glyphSize) {
+		glyphSize = glyphSize ? glyphSize * 2 : 1024;
+		glyphs = realloc(glyphs, glyphSize * sizeof(*glyphs));
+		if (glyphs == NULL) {
+			fprintf(stderr, "glyphbench: out of memory\n");
+			exit(1);
+		}
+	}
+	memcpy(glyphs[glyphCount++], bitmap, CHAR_HEIGHT);
+}
+
+
+// Every frame of a recording through Packets_to_chars(), all 47 glyphs of each
+static _Bool AddRecording(const char* path) {
+	FILE* f = fopen(path, "rb");
+	if (f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	uint8_t entry[GLYPH_ENTRY_SIZE];
+	while (fread(entry, 1, GLYPH_ENTRY_SIZE, f) == GLYPH_ENTRY_SIZE) {
+		memcpy(vfdReplayFrame, entry + 4, GLYPH_FRAME_SIZE);
+		vfdReplayRequest++;
+		VFD_CaptureReplayPoll();
+		VFD_CaptureAcquire();
+		Packets_to_chars();
+
+		for (int i = 0; i < CHAR_COUNT; i++) AddGlyph(chars[i]);
+	}
+	fclose(f);
+	return true;
+}
+
+
+static uint64_t NowNs(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+
+int main(int argc, char** argv) {
+	int passes = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		switch (opt) {
+		case 'n':	passes = atoi(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-n passes] [frames.vfdr ...]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	BitmapLookup_Init();
+	VFD_CaptureInit();
+	vfdReplayMode = 1;
+
+	for (int i = optind; i < argc; i++) {
+		if (!AddRecording(argv[i])) return 1;
+	}
+	if (optind == argc) {
+		static const uint8_t unknown[CHAR_HEIGHT] = { 0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F };
+		for (uint32_t i = 0; i < bitmapCharCount; i++) AddGlyph(bitmap_characters[i].bitmap);
+		AddGlyph(unknown);
+	}
+	if (glyphCount == 0) {
+		fprintf(stderr, "glyphbench: no frames\n");
+		return 1;
+	}
+	if (passes <= 0) passes = 1 + 20000000 / glyphCount;		// Some tens of millions of lookups either way
+
+	// Same answer for every glyph, before anything is timed
+	for (uint32_t i = 0; i < glyphCount; i++) {
+		char hashed = BitmapToChar(glyphs[i]);
+		char linear = LinearBitmapToChar(glyphs[i]);
+		if (hashed != linear) {
+			fprintf(stderr, "glyphbench: glyph %lu: hash lookup '%c', linear scan '%c'\n", (unsigned long)i,
+				hashed, linear);
+			return 1;
+		}
+	}
+	double comparesPerLookup = (double)linearCompares / glyphCount;
+	uint64_t unmatched = linearMisses;
+
+	uint32_t sum = 0;		// Keeps the lookups from being optimised away
+	uint64_t t = NowNs();
+	for (int p = 0; p < passes; p++) {
+		for (uint32_t i = 0; i < glyphCount; i++) sum += (uint8_t)LinearBitmapToChar(glyphs[i]);
+	}
+	uint64_t linearNs = NowNs() - t;
+
+	t = NowNs();
+	for (int p = 0; p < passes; p++) {
+		for (uint32_t i = 0; i < glyphCount; i++) sum += (uint8_t)BitmapToChar(glyphs[i]);
+	}
+	uint64_t hashNs = NowNs() - t;
+
+	double lookups = (double)passes * glyphCount;
+	printf("%lu glyphs (%lu not in the table), %d passes, checksum %08lx\n", (unsigned long)glyphCount,
+		(unsigned long)unmatched, passes, (unsigned long)sum);
+	printf("linear scan  %7.2f ns per lookup, %.1f compares\n", linearNs / lookups, comparesPerLookup);
+	printf("hash lookup  %7.2f ns per lookup, %.1fx faster\n", hashNs / lookups,
+		hashNs ? (double)linearNs / hashNs : 0.0);
+
+	free(glyphs);
+	return 0;
+}
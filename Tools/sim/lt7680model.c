@@ -0,0 +1,384 @@
+/**
+  ******************************************************************************
+  * @file    lt7680model.c
+  * @brief   This file provides a register level model of the LT7680 for
+  *          the host simulator: the register file, the display memory and
+  *          the engines the firmware uses.
+  ******************************************************************************
+*/
+
+// Only what the firmware drives is modelled, and only to the point of getting the pixels right:
+// - The SPI frame: [0x00, reg] selects a register, [0x80, value] writes it, [0x40, x] reads STSR, [0xC0, x] reads
+//   the selected register.
+// - Every engine finishes at once. STSR always reads write FIFO empty, SDRAM ready, core idle, so status polls pass
+//   on the first read, and the boot waits (PLL lock REG[00h] bit 7, SDRAM REG[E4h] bit 0) and VSYNC (REG[0Ch]) read
+//   as ready. The bus traffic is still exactly what the firmware sends.
+// - Text engine (REG[03h] bit 2): CGROM characters in 8x16 / 12x24 / 16x32 cells with the width and height factors,
+//   character spacing, chroma keying and the 90 degree rotation, and user-defined characters read from CGRAM.
+//   The CGROM glyphs are the 5x7 VFD font from main.c scaled into the cell, not the LT7680's own font.
+// - Graphic mode memory writes, block (X-Y) at 16bpp and linear at 8bpp, i.e. the CGRAM upload.
+// - Line and rectangle (outline and filled) drawing, BTE memory copy, all 16bpp.
+// Drawing is clipped to the active window, BTE copies are not (as on the LT7680).
+
+#include "lt7680model.h"
+#include "lt7680.h"
+#include "main.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LTM_ADDR_MASK			(LTM_SDRAM_SIZE - 1)
+
+uint8_t ltmRegs[256];
+uint8_t* ltmSdram = NULL;
+uint32_t ltmTextChars = 0;
+uint32_t ltmBteCopies = 0;
+uint32_t ltmShapes = 0;
+
+static uint8_t ltmSelected = 0;				// Register selected by the last command write
+static int ltmUcgHigh = -1;					// UCG code high byte waiting for its low byte, -1 = none
+static int ltmPixelLow = -1;				// 16bpp graphic write low byte waiting for its high byte, -1 = none
+static uint32_t ltmLinear = 0;				// Linear mode write address
+static uint16_t ltmGx = 0, ltmGy = 0;		// Block mode write position
+static const BitmapChar* ltmCgrom[256];		// Glyph for each character code, NULL = not in the VFD font
+
+
+//******************************************************************************
+// Registers
+
+static uint16_t Reg16(uint8_t reg) {
+	return (uint16_t)(ltmRegs[reg] | (ltmRegs[reg + 1] << 8));
+}
+
+static uint32_t Reg32(uint8_t reg) {
+	return (uint32_t)ltmRegs[reg] | ((uint32_t)ltmRegs[reg + 1] << 8) | ((uint32_t)ltmRegs[reg + 2] << 16) | ((uint32_t)ltmRegs[reg + 3] << 24);
+}
+
+static void SetReg16(uint8_t reg, uint16_t value) {
+	ltmRegs[reg] = value & 0xFF;
+	ltmRegs[reg + 1] = (value >> 8) & 0x1F;
+}
+
+// RGB565 from the 8-bit R, G, B colour registers (the LT7680 takes the upper bits at 16bpp)
+static uint16_t Rgb565(uint8_t reg) {
+	return (uint16_t)(((ltmRegs[reg] >> 3) << 11) | ((ltmRegs[reg + 1] >> 2) << 5) | (ltmRegs[reg + 2] >> 3));
+}
+
+
+//******************************************************************************
+// Display memory
+
+// One pixel on the canvas, clipped to the active window
+static void PutPixel(int x, int y, uint16_t color) {
+	int awX = Reg16(0x56) & 0x1FFF;
+	int awY = Reg16(0x58) & 0x1FFF;
+	int awW = Reg16(0x5A) & 0x1FFF;
+	int awH = Reg16(0x5C) & 0x1FFF;
+	int width = Reg16(0x54) & 0x3FFF;
+
+	if (x < awX || y < awY || x >= awX + awW || y >= awY + awH || x >= width) return;
+
+	uint32_t addr = Reg32(0x50) + ((uint32_t)y * width + x) * 2;
+	ltmSdram[addr & LTM_ADDR_MASK] = color & 0xFF;
+	ltmSdram[(addr + 1) & LTM_ADDR_MASK] = color >> 8;
+}
+
+static void FillBox(int x0, int y0, int x1, int y1, uint16_t color) {
+	for (int y = y0; y <= y1; y++) {
+		for (int x = x0; x <= x1; x++) {
+			PutPixel(x, y, color);
+		}
+	}
+}
+
+
+//******************************************************************************
+// Text engine
+
+// Is pixel (gx, gy) of character 'code' set, in a w x h cell
+static int GlyphPixel(uint8_t source, uint16_t code, int gx, int gy, int w, int h) {
+	if (source == 0b10) {
+		// User-defined: CGRAM slot 'code', whole bytes per row, MSB leftmost
+		int rowBytes = (w + 7) / 8;
+		uint32_t addr = Reg32(0xDB) + (uint32_t)code * rowBytes * h + (uint32_t)gy * rowBytes + gx / 8;
+		return (ltmSdram[addr & LTM_ADDR_MASK] & (0x80 >> (gx % 8))) != 0;
+	}
+
+	const BitmapChar* glyph = ltmCgrom[code & 0xFF];
+	if (glyph == NULL) {
+		return gx == 1 || gx == w - 2 || gy == 1 || gy == h - 2;	// Not in the font, an outline box
+	}
+
+	// 5x7 scaled into the cell, a column to the right and a row above and below left blank
+	int fx = gx * 6 / w;
+	int fy = gy * 9 / h - 1;
+	if (fx > 4 || fy < 0 || fy > 6) return 0;
+	return (glyph->bitmap[fy] & (0x10 >> fx)) != 0;
+}
+
+// Draw one character at the text cursor and move the cursor on
+static void EngineText(uint16_t code) {
+	uint8_t ccr0 = ltmRegs[0xCC];
+	uint8_t ccr1 = ltmRegs[0xCD];
+	uint8_t source = ccr0 >> 6;
+	int h = ((ccr0 >> 4) & 0x03) == 0b10 ? 32 : ((ccr0 >> 4) & 0x03) == 0b01 ? 24 : 16;
+	int w = h / 2;
+	int wf = ((ccr1 >> 2) & 0x03) + 1;
+	int hf = (ccr1 & 0x03) + 1;
+	int rotated = (ccr1 & 0x10) != 0;
+	int chroma = (ccr1 & 0x40) != 0;
+	int cx = Reg16(0x63) & 0x1FFF;
+	int cy = Reg16(0x65) & 0x1FFF;
+	uint16_t fg = Rgb565(0xD2);
+	uint16_t bg = Rgb565(0xD5);
+
+	for (int gy = 0; gy < h; gy++) {
+		for (int gx = 0; gx < w; gx++) {
+			int on = GlyphPixel(source, code, gx, gy, w, h);
+			if (!on && chroma) continue;
+
+			// Rotated 90 degrees counterclockwise: the glyph's rows run along X and the text advances down Y
+			int x = rotated ? cx + gy * hf : cx + gx * wf;
+			int y = rotated ? cy + gx * wf : cy + gy * hf;
+			int sx = rotated ? hf : wf;
+			int sy = rotated ? wf : hf;
+			FillBox(x, y, x + sx - 1, y + sy - 1, on ? fg : bg);
+		}
+	}
+
+	int advance = w * wf + (ltmRegs[0xD1] & 0x3F);
+	if (rotated) {
+		SetReg16(0x65, (uint16_t)(cy + advance));
+	} else {
+		SetReg16(0x63, (uint16_t)(cx + advance));
+	}
+	ltmTextChars++;
+}
+
+
+//******************************************************************************
+// Memory data port REG[04h]
+
+static void MemoryWrite(uint8_t value) {
+	if (ltmRegs[0x03] & 0x04) {
+		// Text mode, a user-defined character is a 2-byte code, high byte first
+		if ((ltmRegs[0xCC] >> 6) == 0b10) {
+			if (ltmUcgHigh < 0) {
+				ltmUcgHigh = value;
+				return;
+			}
+			EngineText((uint16_t)((ltmUcgHigh << 8) | value));
+			ltmUcgHigh = -1;
+			return;
+		}
+		EngineText(value);
+		return;
+	}
+
+	if (ltmRegs[0x5E] & 0x04) {
+		// Linear addressing, 8bpp: byte after byte from the address in 5Fh-62h
+		ltmSdram[ltmLinear & LTM_ADDR_MASK] = value;
+		ltmLinear++;
+		return;
+	}
+
+	// Block mode, 16bpp: low byte then high byte, left to right then down within the active window
+	if (ltmPixelLow < 0) {
+		ltmPixelLow = value;
+		return;
+	}
+	PutPixel(ltmGx, ltmGy, (uint16_t)(ltmPixelLow | (value << 8)));
+	ltmPixelLow = -1;
+	if (++ltmGx >= (Reg16(0x56) & 0x1FFF) + (Reg16(0x5A) & 0x1FFF)) {
+		ltmGx = Reg16(0x56) & 0x1FFF;
+		ltmGy++;
+	}
+}
+
+
+//******************************************************************************
+// Drawing engines
+
+static void EngineLine(void) {
+	int x0 = Reg16(0x68) & 0x1FFF, y0 = Reg16(0x6A) & 0x1FFF;
+	int x1 = Reg16(0x6C) & 0x1FFF, y1 = Reg16(0x6E) & 0x1FFF;
+	int dx = abs(x1 - x0), sx = (x0 < x1) ? 1 : -1;
+	int dy = -abs(y1 - y0), sy = (y0 < y1) ? 1 : -1;
+	int err = dx + dy;
+	uint16_t color = Rgb565(0xD2);
+
+	for (;;) {
+		PutPixel(x0, y0, color);
+		if (x0 == x1 && y0 == y1) break;
+		int e2 = 2 * err;
+		if (e2 >= dy) { err += dy; x0 += sx; }
+		if (e2 <= dx) { err += dx; y0 += sy; }
+	}
+	ltmShapes++;
+}
+
+static void EngineRect(int fill) {
+	int x0 = Reg16(0x68) & 0x1FFF, y0 = Reg16(0x6A) & 0x1FFF;
+	int x1 = Reg16(0x6C) & 0x1FFF, y1 = Reg16(0x6E) & 0x1FFF;
+	uint16_t color = Rgb565(0xD2);
+
+	if (x1 < x0) { int t = x0; x0 = x1; x1 = t; }
+	if (y1 < y0) { int t = y0; y0 = y1; y1 = t; }
+
+	if (fill) {
+		FillBox(x0, y0, x1, y1, color);
+	} else {
+		FillBox(x0, y0, x1, y0, color);
+		FillBox(x0, y1, x1, y1, color);
+		FillBox(x0, y0, x0, y1, color);
+		FillBox(x1, y0, x1, y1, color);
+	}
+	ltmShapes++;
+}
+
+// BTE memory copy with ROP, S0 to the destination, 16bpp. Other operations are not used by the firmware.
+static void EngineBte(void) {
+	uint32_t src = Reg32(0x93), dst = Reg32(0xA7);
+	int srcW = Reg16(0x97) & 0x1FFF, dstW = Reg16(0xAB) & 0x1FFF;
+	int sx = Reg16(0x99) & 0x1FFF, sy = Reg16(0x9B) & 0x1FFF;
+	int dx = Reg16(0xAD) & 0x1FFF, dy = Reg16(0xAF) & 0x1FFF;
+	int w = Reg16(0xB1) & 0x1FFF, h = Reg16(0xB3) & 0x1FFF;
+
+	if ((ltmRegs[0x91] & 0x0F) != 0x02) {
+		fprintf(stderr, "lt7680model: BTE operation %02X not modelled\n", ltmRegs[0x91]);
+		return;
+	}
+
+	for (int row = 0; row < h; row++) {
+		uint32_t s = (src + ((uint32_t)(sy + row) * srcW + sx) * 2) & LTM_ADDR_MASK;
+		uint32_t d = (dst + ((uint32_t)(dy + row) * dstW + dx) * 2) & LTM_ADDR_MASK;
+		if (s + w * 2 > LTM_SDRAM_SIZE || d + w * 2 > LTM_SDRAM_SIZE) continue;
+		memmove(&ltmSdram[d], &ltmSdram[s], (size_t)w * 2);
+	}
+	ltmBteCopies++;
+}
+
+
+//******************************************************************************
+// SPI
+
+static void RegWrite(uint8_t reg, uint8_t value) {
+	switch (reg) {
+	case 0x04:
+		MemoryWrite(value);
+		return;
+
+	case 0x0C:
+		ltmRegs[reg] &= ~value;				// INTF, write 1 to clear
+		return;
+
+	case 0x5F: case 0x60: case 0x61: case 0x62:
+		ltmRegs[reg] = value;				// Linear address, or block X / Y
+		ltmLinear = Reg32(0x5F);
+		ltmGx = Reg16(0x5F) & 0x1FFF;
+		ltmGy = Reg16(0x61) & 0x1FFF;
+		ltmPixelLow = -1;
+		return;
+
+	case 0x67:
+		ltmRegs[reg] = value & 0x7F;		// Done at once
+		if (value & 0x80) EngineLine();
+		return;
+
+	case 0x76:
+		ltmRegs[reg] = value & 0x7F;
+		if ((value & 0x80) && ((value >> 4) & 0x03) == 0b10) EngineRect(value & 0x40);
+		return;
+
+	case 0x90:
+		ltmRegs[reg] = value & ~0x10;
+		if (value & 0x10) EngineBte();
+		return;
+
+	default:
+		ltmRegs[reg] = value;
+		return;
+	}
+}
+
+static uint8_t RegRead(uint8_t reg) {
+	switch (reg) {
+	case 0x00:	return ltmRegs[reg] | 0x80;		// PLL locked
+	case 0x0C:	return ltmRegs[reg] | LT_INT_VSYNC;	// Always in vertical blank
+	case 0xE4:	return ltmRegs[reg] | 0x01;		// SDRAM initialised
+	default:	return ltmRegs[reg];
+	}
+}
+
+
+void LtModel_Init(void) {
+	if (ltmSdram == NULL) {
+		ltmSdram = calloc(LTM_SDRAM_SIZE, 1);
+		if (ltmSdram == NULL) {
+			fprintf(stderr, "lt7680model: no memory for the SDRAM\n");
+			exit(1);
+		}
+	}
+	memset(ltmSdram, 0, LTM_SDRAM_SIZE);
+	memset(ltmRegs, 0, sizeof(ltmRegs));
+	ltmSelected = 0;
+	ltmUcgHigh = -1;
+	ltmPixelLow = -1;
+
+	// CGROM stand-in: the VFD font in main.c, the first entry wins where it has the same character twice
+	memset(ltmCgrom, 0, sizeof(ltmCgrom));
+	for (int i = 0; i < bitmapCharCount; i++) {
+		uint8_t c = (uint8_t)bitmap_characters[i].ascii;
+		if (ltmCgrom[c] == NULL) ltmCgrom[c] = &bitmap_characters[i];
+	}
+}
+
+
+// One CS cycle, returns the byte the LT7680 clocks out during the second byte
+uint8_t LtModel_Frame(uint8_t control, uint8_t data) {
+	if (ltmSdram == NULL) LtModel_Init();
+
+	switch (control) {
+	case 0x00:							// Command write
+		ltmSelected = data;
+		ltmUcgHigh = -1;
+		ltmPixelLow = -1;
+		return 0xFF;
+	case 0x80:							// Data write
+		RegWrite(ltmSelected, data);
+		return 0xFF;
+	case 0x40:							// Status read
+		return LTM_STATUS;
+	case 0xC0:							// Data read
+		return RegRead(ltmSelected);
+	default:
+		return 0xFF;
+	}
+}
+
+
+// The page MISA points at, as the panel shows it: the 400x960 image is portrait, the panel is mounted landscape,
+// so memory X runs down the picture and memory Y across it. Binary PPM, 960x400.
+int LtModel_WritePpm(const char* path) {
+	FILE* f = fopen(path, "wb");
+	if (f == NULL) return -1;
+
+	uint32_t misa = Reg32(0x20);
+	int width = Reg16(0x24) & 0x1FFF;
+	if (width == 0) width = LCD_XSIZE_TFT;
+
+	fprintf(f, "P6\n%d %d\n255\n", LCD_YSIZE_TFT, width);
+	for (int x = 0; x < width; x++) {
+		for (int y = 0; y < LCD_YSIZE_TFT; y++) {
+			uint32_t addr = (misa + ((uint32_t)y * width + x) * 2) & LTM_ADDR_MASK;
+			uint16_t c = (uint16_t)(ltmSdram[addr] | (ltmSdram[addr + 1] << 8));
+			uint8_t rgb[3] = {
+				(uint8_t)(((c >> 11) & 0x1F) * 255 / 31),
+				(uint8_t)(((c >> 5) & 0x3F) * 255 / 63),
+				(uint8_t)((c & 0x1F) * 255 / 31)
+			};
+			fwrite(rgb, 1, 3, f);
+		}
+	}
+	return fclose(f);
+}
@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file    lt7680model.h
+  * @brief   This file contains all the function prototypes for
+  *          the lt7680model.c file
+  ******************************************************************************
+*/
+
+#ifndef LT7680MODEL_H
+#define LT7680MODEL_H
+
+#include <stdint.h>
+
+#define LTM_SDRAM_SIZE			0x1000000	// 128 Mbit
+#define LTM_STATUS				0x44		// STSR: write FIFO empty, SDRAM ready, never busy
+
+// Externally accessible variables
+extern uint8_t ltmRegs[256];				// Register file as last written
+extern uint8_t* ltmSdram;					// Display memory, RGB565 little endian at 16bpp
+extern uint32_t ltmTextChars;				// Characters drawn by the text engine, CGROM and UCG
+extern uint32_t ltmBteCopies;
+extern uint32_t ltmShapes;					// Lines and rectangles
+
+// Function prototypes
+void LtModel_Init(void);
+uint8_t LtModel_Frame(uint8_t control, uint8_t data);
+int LtModel_WritePpm(const char* path);
+
+#endif // LT7680MODEL_H
@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    lt7680sim.c
+  * @brief   Host simulator: boots the firmware's LT7680 set-up against the
+  *          register model, renders frames through RenderPass() and reports
+  *          the SPI1 traffic of each one.
+  ******************************************************************************
+*/
+
+// Usage: lt7680sim [-n frames] [-o screen.ppm]
+//
+// The boot is main()'s, minus what has no host equivalent (clock tree, ST7701S bit bang, settings page). Each
+// frame then sets G[] and Annunc[] to a demo reading, runs one RenderPass(true) exactly as the main loop does, and
+// prints what went over SPI1 for it: bytes, CS cycles (of which reads) and the time SCK ran at the tuned clock.
+// The firmware's own ltSpiBytes / ltSpiTransactions are checked against what the bus saw, so a frame sent behind
+// their back (or counted twice) fails the run. The last frame is written out as a PPM, as the panel shows it.
+
+#include "main.h"
+#include "lt7680.h"
+#include "displaylist.h"
+#include "display.h"
+#include "simhal.h"
+#include "lt7680model.h"
+#include "simboot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+	SimBus bus;
+	uint32_t ltBytes;
+	uint32_t ltTransactions;
+	uint64_t ns;
+} SimSnapshot;
+
+
+static SimSnapshot Snapshot(void) {
+	return (SimSnapshot){ simBus, ltSpiBytes, ltSpiTransactions, simNs };
+}
+
+
+// Print the traffic since 'from', false if the firmware's counters disagree with the bus
+static _Bool Report(const char* label, const SimSnapshot* from) {
+	SimSnapshot now = Snapshot();
+	uint32_t bytes = now.bus.bytes - from->bus.bytes;
+	uint32_t cs = now.bus.transactions - from->bus.transactions;
+
+	printf("%-8s %8lu %7lu %6lu %10.1f %10.1f\n", label,
+		(unsigned long)bytes, (unsigned long)cs, (unsigned long)(now.bus.reads - from->bus.reads),
+		(now.bus.busNs - from->bus.busNs) / 1000.0, (now.ns - from->ns) / 1000.0);
+
+	if (now.ltBytes - from->ltBytes != bytes || now.ltTransactions - from->ltTransactions != cs) {
+		fprintf(stderr, "lt7680sim: %s: firmware counted %lu bytes / %lu CS, the bus saw %lu / %lu\n", label,
+			(unsigned long)(now.ltBytes - from->ltBytes), (unsigned long)(now.ltTransactions - from->ltTransactions),
+			(unsigned long)bytes, (unsigned long)cs);
+		return false;
+	}
+	return true;
+}
+
+
+// A reading that changes a few digits each frame, with SMPL blinking and the Ohm symbol every fourth frame
+static void DemoFrame(int frame) {
+	char mainLine[LINE1_LEN + 1];
+	char auxLine[LINE2_LEN + 1];
+
+	if (frame % 4 == 3) {
+		snprintf(mainLine, sizeof(mainLine), " %11.4f K$   ", 10.0 + (frame % 1000) * 0.0137);
+	} else {
+		snprintf(mainLine, sizeof(mainLine), " %+12.8f VDC ", 1.0 + (frame % 1000) * 0.00000317);
+	}
+	snprintf(auxLine, sizeof(auxLine), "NPLC 100 TRIG AUTO  #%-8d", frame % 100000000);
+
+	for (int i = 0; i < LINE1_LEN; i++) G[1 + i] = mainLine[i] ? mainLine[i] : ' ';
+	for (int i = 0; i < LINE2_LEN; i++) G[1 + LINE1_LEN + i] = auxLine[i] ? auxLine[i] : ' ';
+	for (int i = 1; i <= 18; i++) Annunc[i] = false;
+	Annunc[1] = frame & 1;					// SMPL
+	Annunc[3] = true;						// AUTO
+	Annunc[15] = frame >= 2;				// RMT
+}
+
+
+int main(int argc, char** argv) {
+	int frames = 10;
+	const char* ppm = "lt7680sim.ppm";
+	int opt;
+	_Bool ok = true;
+
+	while ((opt = getopt(argc, argv, "n:o:")) != -1) {
+		switch (opt) {
+		case 'n':	frames = atoi(optarg); break;
+		case 'o':	ppm = optarg; break;
+		default:
+			fprintf(stderr, "usage: %s [-n frames] [-o screen.ppm]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	printf("%-8s %8s %7s %6s %10s %10s\n", "", "bytes", "CS", "reads", "bus us", "sim us");
+
+	SimSnapshot s = Snapshot();
+	SimBoot();
+	ok &= Report("boot", &s);
+
+	SimSnapshot total = Snapshot();
+	for (int f = 0; f < frames; f++) {
+		char label[24];
+		snprintf(label, sizeof(label), "frame %d", f);
+
+		DemoFrame(f);
+		s = Snapshot();
+		RenderPass(true);
+		LT_DisplayListWait();
+		ok &= Report(label, &s);
+	}
+	if (frames > 0) ok &= Report("frames", &total);
+
+	printf("SPI1 prescaler %lu, text burst %u, BTE copies %lu, text chars %lu, page flips %lu, wait timeouts %lu\n",
+		(unsigned long)(2U << ((ltSpiPrescaler & SPI_CR1_BR) >> SPI_CR1_BR_Pos)), textFifoBurst,
+		(unsigned long)ltmBteCopies, (unsigned long)ltmTextChars, (unsigned long)ltPageFlips, (unsigned long)ltWaitTimeouts);
+
+	if (LtModel_WritePpm(ppm) != 0) {
+		fprintf(stderr, "lt7680sim: cannot write %s\n", ppm);
+		return 1;
+	}
+	printf("Screen written to %s\n", ppm);
+
+	return ok ? 0 : 1;
+}
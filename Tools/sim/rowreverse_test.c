@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    rowreverse_test.c
+  * @brief   Host test: Packets_to_chars() with the RowReverse[] table gives
+  *          bit for bit what the InverseByte() code it replaced gave.
+  ******************************************************************************
+*/
+
+// Usage: rowreverse_test
+//
+// Every row of a cell depends on at most two of its packet's five bytes, so running every pair of byte positions
+// through all 65536 value combinations puts every input the table can see through both versions. The bytes not in
+// the pair are held at 0x00, at 0xFF and at pseudo-random values in turn. Frames go in through the replay slot and
+// are decoded by the firmware's own Packets_to_chars(); chars[][] and flags[] must match the reference below, which
+// is the code as it was before RowReverse[], for all 47 cells of every frame. Exits 1 on the first difference.
+
+#include "main.h"
+#include "vfdcapture.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_FRAME_SIZE			(PACKET_WIDTH * PACKET_COUNT)
+
+// Packets_to_chars() output and the cell order it uses, in main.c
+extern uint8_t chars[CHAR_COUNT][CHAR_HEIGHT];
+extern uint8_t flags[CHAR_COUNT];
+extern const uint8_t Reorder[PACKET_COUNT];
+
+static uint32_t testFrames = 0;
+static uint32_t testCells = 0;
+static uint32_t randomState = 0x12345678;
+
+
+// The bit reversal and row unpacking as they were, before the table
+static uint8_t InverseByte(uint8_t a) {
+	a = ((a & 0x55) << 1) | ((a & 0xAA) >> 1);
+	a = ((a & 0x33) << 2) | ((a & 0xCC) >> 2);
+	return (a >> 4) | (a << 4);
+}
+
+
+static void ReferenceCell(const uint8_t* packet, uint8_t* row, uint8_t* flag) {
+	uint8_t d0 = packet[0];
+	uint8_t d1 = packet[1];
+	uint8_t d2 = packet[2];
+	uint8_t d3 = packet[3];
+	uint8_t d4 = packet[4];
+
+	row[0] = 0x1F & InverseByte((d1 << 4) | ((d2 & 0x80) >> 4));
+	row[1] = 0x1F & InverseByte((d0 << 7) | ((d1 & 0xF0) >> 1));
+	row[2] = 0x1F & InverseByte((d0 & 0xFE) << 2);
+	row[3] = 0x1F & InverseByte(((d0 & 0xC0) >> 3) | (d4 << 5));
+	row[4] = 0x1F & InverseByte(d4 & 0xF8);
+	row[5] = 0x1F & InverseByte(d3 << 3);
+	row[6] = 0x1F & InverseByte((d2 << 6) | ((d3 & 0xE0) >> 2));
+	*flag = (d2 & 0x40) == 0x40;
+}
+
+
+static uint8_t RandomByte(void) {
+	randomState = randomState * 1664525u + 1013904223u;
+	return (uint8_t)(randomState >> 24);
+}
+
+
+// Decode one frame through the firmware and compare every cell with the reference
+static _Bool CheckFrame(const uint8_t* frame) {
+	memcpy(vfdReplayFrame, frame, TEST_FRAME_SIZE);
+	vfdReplayRequest++;
+	VFD_CaptureReplayPoll();
+	VFD_CaptureAcquire();
+	Packets_to_chars();
+	testFrames++;
+
+	for (int i = 0; i < PACKET_COUNT; i++) {
+		const uint8_t* packet = &frame[i * PACKET_WIDTH];
+		uint8_t row[CHAR_HEIGHT];
+		uint8_t flag;
+
+		ReferenceCell(packet, row, &flag);
+		testCells++;
+		if (memcmp(row, chars[Reorder[i]], CHAR_HEIGHT) != 0 || flag != flags[Reorder[i]]) {
+			fprintf(stderr, "rowreverse_test: packet %02x %02x %02x %02x %02x (cell %u): ", packet[0], packet[1],
+				packet[2], packet[3], packet[4], Reorder[i]);
+			for (int r = 0; r < CHAR_HEIGHT; r++) fprintf(stderr, "%02x/%02x ", chars[Reorder[i]][r], row[r]);
+			fprintf(stderr, "flag %u/%u (table/reference)\n", flags[Reorder[i]], flag);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+int main(void) {
+	static const char* const fills[] = { "0x00", "0xFF", "random" };
+	uint8_t frame[TEST_FRAME_SIZE];
+
+	VFD_CaptureInit();
+	vfdReplayMode = 1;
+
+	for (int fill = 0; fill < 3; fill++) {
+		for (int p = 0; p < PACKET_WIDTH; p++) {
+			for (int q = p + 1; q < PACKET_WIDTH; q++) {
+				// All 65536 (byte p, byte q) combinations, 47 to a frame
+				uint32_t value = 0;
+				while (value < 0x10000) {
+					for (int i = 0; i < PACKET_COUNT; i++, value++) {
+						uint8_t* packet = &frame[i * PACKET_WIDTH];
+						for (int b = 0; b < PACKET_WIDTH; b++) {
+							packet[b] = fill == 0 ? 0x00 : fill == 1 ? 0xFF : RandomByte();
+						}
+						packet[p] = (uint8_t)(value & 0xFF);
+						packet[q] = (uint8_t)(value >> 8);		// The last frame wraps round to the first values
+					}
+					if (!CheckFrame(frame)) return 1;
+				}
+			}
+		}
+		printf("other bytes %-6s  every byte pair, all values: same\n", fills[fill]);
+	}
+
+	printf("%lu frames, %lu cells: chars[][] and flags[] identical\n", (unsigned long)testFrames,
+		(unsigned long)testCells);
+	return 0;
+}
@@ -0,0 +1,48 @@
+/**
+  ******************************************************************************
+  * @file    simboot.c
+  * @brief   This file provides the firmware's boot sequence for the host
+  *          tools, as far as it reaches the LT7680 and the VFD capture.
+  ******************************************************************************
+*/
+
+#include "simboot.h"
+#include "main.h"
+#include "gpio.h"
+#include "dma.h"
+#include "spi.h"
+#include "timer.h"
+#include "lt7680.h"
+#include "displaylist.h"
+#include "display.h"
+#include "profile.h"
+#include "vfdcapture.h"
+
+
+// main()'s boot in the same order, less what has no host equivalent: the clock tree, the ST7701S bit bang and the
+// settings page (blank, so the SPI1 clock is tuned from the safe one). Double buffered, as outside timing adjust.
+void SimBoot(void) {
+	Boot_Init();
+	HAL_Init();
+	MX_GPIO_Init();
+	MX_DMA_Init();
+	LT_DisplayListInit();
+	MX_SPI1_Init();
+	MX_SPI2_Init();
+	TIM2_Init();
+	BitmapLookup_Init();
+	VFD_CaptureInit();
+	Profile_Init();
+
+	HardwareReset();
+	SendAllToLT7680_LT();
+	ltSpiPrescaler = LT_SpiAutoTune(0xFFFFFFFF);
+	LT_TextFifoLearnDepth();
+	ClearScreen();
+	ConfigurePWMAndSetBrightness(BACKLIGHTFULL);
+	ClearScreen();
+	DisplayInvalidate();
+	DisplayAtlasInit();
+	LT_PageInit();
+	DisplayInvalidate();
+}
@@ -0,0 +1,15 @@
+/**
+  ******************************************************************************
+  * @file    simboot.h
+  * @brief   This file contains all the function prototypes for
+  *          the simboot.c file
+  ******************************************************************************
+*/
+
+#ifndef SIMBOOT_H
+#define SIMBOOT_H
+
+// Function prototypes
+void SimBoot(void);
+
+#endif // SIMBOOT_H
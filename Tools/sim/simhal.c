@@ -0,0 +1,325 @@
+/**
+  ******************************************************************************
+  * @file    simhal.c
+  * @brief   This file provides the host simulator's stand-ins for the
+  *          STM32 HAL, the peripherals and the interrupts.
+  ******************************************************************************
+*/
+
+// The firmware sources are compiled unchanged apart from LT_HOST_SIM, which routes every SPI1 frame through
+// LtSim_Frame() here instead of the SPI1 data register. Everything else they touch is host RAM:
+//
+// - Peripheral registers (stub/stm32f1xx.h) are the structs below. Register writes land in them and register
+//   reads see what was written, which is all the init code and the display list engine need.
+// - HAL calls are no-ops that succeed, apart from the tick and the GPIOs. The CRC unit is done in software.
+// - Time is simulated. It only moves when something takes time on the real board: an SPI1 frame (16 bits at the
+//   SPI1 clock in use), HAL_Delay(), a TIM3 poll interval, a display list pause. DWT->CYCCNT and HAL_GetTick()
+//   follow it at 72 MHz, and SysTick_Handler() runs at every millisecond crossed, so the status poll timeouts and
+//   LT_Delay() behave as on the board.
+// - Interrupts run from SimIrq_Run(), entered when one is pended. It keeps going, acting out the DMA transfer
+//   complete, the TIM3 one pulse and SysTick, until nothing is left for the display list to wait on. A display list
+//   is therefore sent in full by the time LT_DisplayListEnd() returns, and the counts are per render pass.
+
+#include "simhal.h"
+#include "lt7680model.h"
+#include "lt7680.h"
+#include "displaylist.h"
+#include "stm32f1xx_it.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define SIM_NS_PER_MS			1000000ULL
+#define SIM_IRQ_LIMIT_NS		(10000ULL * SIM_NS_PER_MS)	// A display list still going after 10 s is stuck
+
+// Peripheral registers in host RAM
+SPI_TypeDef simSPI1;
+DMA_TypeDef simDMA1;
+DMA_Channel_TypeDef simDMA1_Channel2;
+DMA_Channel_TypeDef simDMA1_Channel3;
+TIM_TypeDef simTIM2;
+TIM_TypeDef simTIM3;
+GPIO_TypeDef simGPIOA;
+GPIO_TypeDef simGPIOB;
+GPIO_TypeDef simGPIOC;
+RCC_TypeDef simRCC;
+DBGMCU_TypeDef simDBGMCU;
+DWT_Type simDWT;
+CoreDebug_Type simCoreDebug;
+SysTick_Type simSysTick;
+
+uint32_t SystemCoreClock = 72000000;
+
+uint64_t simNs = 0;
+SimBus simBus;
+
+static uint64_t simTickedMs = 0;			// Milliseconds SysTick_Handler() has run for
+static _Bool simInTick = false;
+static uint64_t simIrqPending = 0;			// Bit per IRQn
+static _Bool simInIrq = false;
+
+
+//******************************************************************************
+// Time
+
+// Move simulated time on, running SysTick for every millisecond crossed. SysTick never interrupts itself.
+void SimHal_Advance(uint64_t ns) {
+	simNs += ns;
+	DWT->CYCCNT = (uint32_t)(simNs * (SystemCoreClock / 1000000) / 1000);
+
+	if (simInTick) return;
+	simInTick = true;
+	while (simTickedMs < simNs / SIM_NS_PER_MS) {
+		simTickedMs++;
+		SysTick_Handler();
+	}
+	simInTick = false;
+}
+
+
+//******************************************************************************
+// SPI1 to the LT7680
+
+// One CS cycle: the control byte and one more, 16 SCK periods at the prescaler in SPI1 CR1 (PCLK2 = 72 MHz)
+uint8_t LtSim_Frame(uint8_t control, uint8_t data) {
+	uint32_t br = (SPI1->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
+	uint64_t ns = 16ULL * 1000000000ULL * (2U << br) / SystemCoreClock;
+
+	struct timespec t0, t1;
+
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	uint8_t reply = LtModel_Frame(control, data);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	simBus.modelNs += (uint64_t)((t1.tv_sec - t0.tv_sec) * 1000000000LL + (t1.tv_nsec - t0.tv_nsec));
+
+	simBus.bytes += 2;
+	simBus.transactions++;
+	if (control & 0x40) simBus.reads++;
+	simBus.busNs += ns;
+	SimHal_Advance(ns);
+
+	return reply;
+}
+
+
+//******************************************************************************
+// CRC unit
+
+// CRC-32 as the STM32F1 CRC unit computes it: polynomial 0x04C11DB7, initial value 0xFFFFFFFF after a reset,
+// 32-bit words MSB first, no reflection and no final XOR
+uint32_t SimCrc_Words(const uint32_t* words, uint32_t count) {
+	uint32_t crc = 0xFFFFFFFF;
+
+	for (uint32_t i = 0; i < count; i++) {
+		crc ^= words[i];
+		for (int bit = 0; bit < 32; bit++) {
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+
+//******************************************************************************
+// Interrupts
+
+static void SimIrq_Call(uint32_t irq) {
+	switch (irq) {
+	case DMA1_Channel2_IRQn:	DMA1_Channel2_IRQHandler(); break;
+	case DMA1_Channel3_IRQn:	DMA1_Channel3_IRQHandler(); break;
+	case TIM3_IRQn:				TIM3_IRQHandler(); break;
+	default:					break;
+	}
+
+	// DMA interrupt flags clear when written to IFCR, a channel's CGIF clears all four of its flags
+	uint32_t clear = DMA1->IFCR;
+	for (int ch = 0; ch < 7; ch++) {
+		if (clear & (DMA_IFCR_CGIF1 << (ch * 4))) clear |= 0xFU << (ch * 4);
+	}
+	DMA1->ISR &= ~clear;
+	DMA1->IFCR = 0;
+}
+
+
+// Run pended interrupts and what the hardware would do next, until the display list has nothing left to wait for
+static void SimIrq_Run(void) {
+	uint64_t start = simNs;
+
+	simInIrq = true;
+	for (;;) {
+		if (simNs - start > SIM_IRQ_LIMIT_NS) {
+			fprintf(stderr, "sim: display list stuck, %llu ms without completing\n", (unsigned long long)((simNs - start) / SIM_NS_PER_MS));
+			exit(1);
+		}
+
+		// SPI1 RX DMA: the register model answered when the frame was started, so its transfer is complete
+		if ((DMA1_Channel2->CCR & DMA_CCR_EN) && !(DMA1->ISR & DMA_ISR_TCIF2)) {
+			DMA1->ISR |= DMA_ISR_TCIF2 | DMA_ISR_GIF2;
+			if (DMA1_Channel2->CCR & DMA_CCR_TCIE) simIrqPending |= 1ULL << DMA1_Channel2_IRQn;
+		}
+
+		if (simIrqPending) {
+			uint32_t irq = (uint32_t)__builtin_ctzll(simIrqPending);
+			simIrqPending &= ~(1ULL << irq);
+			SimIrq_Call(irq);
+			continue;
+		}
+
+		// TIM3 one pulse, 1 us ticks
+		if (TIM3->CR1 & TIM_CR1_CEN) {
+			SimHal_Advance((uint64_t)(TIM3->ARR + 1) * 1000);
+			TIM3->CR1 &= ~TIM_CR1_CEN;
+			TIM3->SR |= TIM_SR_UIF;
+			if (TIM3->DIER & TIM_DIER_UIE) simIrqPending |= 1ULL << TIM3_IRQn;
+			continue;
+		}
+
+		// Display list paused by LT_Delay(), SysTick resumes it
+		if (!SPI1_TX_completed_flag) {
+			SimHal_Advance(SIM_NS_PER_MS - simNs % SIM_NS_PER_MS);
+			continue;
+		}
+
+		break;
+	}
+	simInIrq = false;
+}
+
+
+void SimIrq_Pend(IRQn_Type irq) {
+	simIrqPending |= 1ULL << irq;
+	if (!simInIrq) SimIrq_Run();
+}
+
+
+//******************************************************************************
+// HAL
+
+HAL_StatusTypeDef HAL_Init(void) {
+	return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void) {
+	return (uint32_t)(simNs / SIM_NS_PER_MS);
+}
+
+void HAL_IncTick(void) {
+	// The tick is simulated time, see SimHal_Advance()
+}
+
+void HAL_Delay(uint32_t Delay) {
+	SimHal_Advance((uint64_t)(Delay + 1) * SIM_NS_PER_MS);	// +1 as the HAL does, at least Delay ms
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority) {
+	(void)IRQn; (void)PreemptPriority; (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {
+	(void)IRQn;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {
+	(void)IRQn;
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef* RCC_OscInitStruct) {
+	(void)RCC_OscInitStruct;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef* RCC_ClkInitStruct, uint32_t FLatency) {
+	(void)RCC_ClkInitStruct; (void)FLatency;
+	return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void) {
+	return SystemCoreClock;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_Init) {
+	(void)GPIOx; (void)GPIO_Init;
+}
+
+void HAL_GPIO_DeInit(GPIO_TypeDef* GPIOx, uint32_t GPIO_Pin) {
+	(void)GPIOx; (void)GPIO_Pin;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+	if (PinState == GPIO_PIN_SET) GPIOx->ODR |= GPIO_Pin;
+	else GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+}
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin) {
+	GPIOx->ODR ^= GPIO_Pin;
+}
+
+void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin) {
+	(void)GPIO_Pin;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma) {
+	(void)hdma;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef* hdma) {
+	(void)hdma;
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma) {
+	(void)hdma;
+}
+
+// SPI1 starts at the prescaler MX_SPI1_Init() asks for, as HAL_SPI_Init() would set it. SPI2 (the VFD) is not
+// modelled, frames come from the replay slot instead.
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef* hspi) {
+	if (hspi->Instance == SPI1) {
+		SPI1->CR1 = SPI_CR1_MSTR | hspi->Init.BaudRatePrescaler;
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef* hspi, uint8_t* pData, uint16_t Size) {
+	(void)hspi; (void)pData; (void)Size;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef* hspi) {
+	(void)hspi;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef* hspi) {
+	(void)hspi;
+	return HAL_OK;
+}
+
+void HAL_SPI_IRQHandler(SPI_HandleTypeDef* hspi) {
+	(void)hspi;
+}
+
+// The settings page is never read or written by the sim, EEPROM_ReadData() would dereference the flash address
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data) {
+	(void)TypeProgram; (void)Address; (void)Data;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef* pEraseInit, uint32_t* PageError) {
+	(void)pEraseInit;
+	*PageError = 0xFFFFFFFF;
+	return HAL_OK;
+}
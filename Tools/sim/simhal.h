@@ -0,0 +1,31 @@
+/**
+  ******************************************************************************
+  * @file    simhal.h
+  * @brief   This file contains all the function prototypes for
+  *          the simhal.c file
+  ******************************************************************************
+*/
+
+#ifndef SIMHAL_H
+#define SIMHAL_H
+
+#include "stm32f1xx_hal.h"
+#include <stdint.h>
+
+// SPI1 traffic to the LT7680 as it went over the bus, every CS cycle blocking or display list
+typedef struct {
+	uint32_t bytes;
+	uint32_t transactions;		// CS cycles
+	uint32_t reads;				// Of which status / data reads
+	uint64_t busNs;				// Time SCK was running, at the SPI1 prescaler in use for each frame
+	uint64_t modelNs;			// Host time spent in the register model for these frames, not the firmware's
+} SimBus;
+
+// Externally accessible variables
+extern uint64_t simNs;			// Simulated time since reset
+extern SimBus simBus;			// Running totals, take differences per frame
+
+// Function prototypes
+void SimHal_Advance(uint64_t ns);
+
+#endif // SIMHAL_H
@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    stm32f1xx.h
+  * @brief   Host simulator stand-in for the CMSIS device header: the real
+  *          header, then the peripherals the firmware reaches directly are
+  *          moved into host RAM and the core intrinsics made harmless.
+  ******************************************************************************
+*/
+
+// Found ahead of Drivers/CMSIS/Device/ST/STM32F1xx/Include by the sim Makefile, so the firmware sources and the
+// HAL headers all see this one. Types, bit definitions and IRQ numbers are the real ones, only the instances move:
+// SPI1, DMA1, TIM2/TIM3 etc. become plain structs in simhal.c, read and written by the code exactly as the
+// registers would be. What the hardware does with them (DMA transfer complete, TIM3 one pulse, SysTick) is acted
+// out by the interrupt loop in simhal.c.
+
+#ifndef SIM_STM32F1XX_H
+#define SIM_STM32F1XX_H
+
+#include_next "stm32f1xx.h"
+
+// Peripheral registers in host RAM (simhal.c)
+extern SPI_TypeDef simSPI1;
+extern DMA_TypeDef simDMA1;
+extern DMA_Channel_TypeDef simDMA1_Channel2;
+extern DMA_Channel_TypeDef simDMA1_Channel3;
+extern TIM_TypeDef simTIM2;
+extern TIM_TypeDef simTIM3;
+extern GPIO_TypeDef simGPIOA;
+extern GPIO_TypeDef simGPIOB;
+extern GPIO_TypeDef simGPIOC;
+extern RCC_TypeDef simRCC;
+extern DBGMCU_TypeDef simDBGMCU;
+extern DWT_Type simDWT;
+extern CoreDebug_Type simCoreDebug;
+extern SysTick_Type simSysTick;
+
+#undef SPI1
+#undef DMA1
+#undef DMA1_Channel2
+#undef DMA1_Channel3
+#undef TIM2
+#undef TIM3
+#undef GPIOA
+#undef GPIOB
+#undef GPIOC
+#undef RCC
+#undef DBGMCU
+#undef DWT
+#undef CoreDebug
+#undef SysTick
+#define SPI1					(&simSPI1)
+#define DMA1					(&simDMA1)
+#define DMA1_Channel2			(&simDMA1_Channel2)
+#define DMA1_Channel3			(&simDMA1_Channel3)
+#define TIM2					(&simTIM2)
+#define TIM3					(&simTIM3)
+#define GPIOA					(&simGPIOA)
+#define GPIOB					(&simGPIOB)
+#define GPIOC					(&simGPIOC)
+#define RCC						(&simRCC)
+#define DBGMCU					(&simDBGMCU)
+#define DWT						(&simDWT)
+#define CoreDebug				(&simCoreDebug)
+#define SysTick					(&simSysTick)
+
+// NVIC: a pended interrupt runs from the sim interrupt loop, enables are not modelled
+void SimIrq_Pend(IRQn_Type irq);
+#undef NVIC_SetPendingIRQ
+#undef NVIC_EnableIRQ
+#define NVIC_SetPendingIRQ(irq)	SimIrq_Pend(irq)
+#define NVIC_EnableIRQ(irq)		((void)(irq))
+
+// Core intrinsics, one thread and no real interrupts to mask
+#define __disable_irq()			((void)0)
+#define __enable_irq()			((void)0)
+#define __get_PRIMASK()			0U
+#define __set_PRIMASK(x)		((void)(x))
+#undef __WFI
+#define __WFI()					((void)0)
+#define __DMB()					((void)0)
+#define __LDREXB(addr)			(*(addr))
+#define __STREXB(value, addr)	((*(addr) = (value)), 0U)
+#define __CLREX()				((void)0)
+
+// CRC unit, the same CRC-32 worked out in software (simhal.c) for the repeated-frame gate in vfdcapture.c
+uint32_t SimCrc_Words(const uint32_t* words, uint32_t count);
+
+#endif // SIM_STM32F1XX_H
@@ -0,0 +1,222 @@
+/**
+  ******************************************************************************
+  * @file    vfdreplay.c
+  * @brief   Host replay: feeds a recorded VFD session (.vfdr) through the
+  *          firmware's decode and render path on the host simulator and
+  *          reports the cost of each frame.
+  ******************************************************************************
+*/
+
+// Usage: vfdreplay [-q] [-o screen.ppm] frames.vfdr
+//
+// frames.vfdr comes from Tools/vfd_record_decode.py -o, one entry per frame the board received: tick (u32 ms, LE)
+// and the 235 raw frame bytes. After the same boot as lt7680sim, simulated time is moved on to each entry's tick
+// and the frame goes in the way the on-board replay slot takes it (vfdReplayFrame[], vfdReplayRequest), then
+// through the main loop's own sequence: VFD_CaptureReplayPoll(), the frame queue, VFD_CaptureAcquire(), the CRC
+// gate, Packets_to_chars() and Main_Aux_R6581() when it changed. A render follows when the main loop's
+// renderMinIntervalMs / renderMaxIdleMs schedule would start one, as RenderPass(true). The 35 ms TIM2 ticks in
+// between only drive the splash and the front panel buttons and are not replayed.
+//
+// One line per frame: tick, what happened (= unchanged, D decoded with the render held back, R the pending change
+// rendered, r refresh of an unchanged screen), the host CPU time of the decode and of the render pass (less the
+// register model's share), the SPI1 bytes and CS cycles of the render, then G[] and Annunc[] as decoded. -q prints
+// the totals only.
+
+#include "main.h"
+#include "lt7680.h"
+#include "displaylist.h"
+#include "display.h"
+#include "vfdcapture.h"
+#include "simhal.h"
+#include "lt7680model.h"
+#include "simboot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define VFDR_FRAME_SIZE			(PACKET_WIDTH * PACKET_COUNT)
+#define VFDR_ENTRY_SIZE			(4 + VFDR_FRAME_SIZE)
+
+// main()'s loop state, the replay runs the loop's decode and render scheduling on it
+extern uint32_t framesDecoded;
+extern _Bool renderPending;
+extern uint32_t renderMinIntervalMs;
+extern uint32_t renderMaxIdleMs;
+
+typedef struct {
+	uint32_t frames;
+	uint32_t decoded;
+	uint32_t rendered;
+	uint64_t decodeNs;
+	uint64_t decodeMaxNs;
+	uint64_t renderNs;
+	uint64_t renderMaxNs;
+	uint32_t spiBytes;
+	uint32_t spiTransactions;
+} ReplayTotals;
+
+
+static uint64_t CpuNs(void) {
+	struct timespec t;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+	return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+}
+
+
+// G[] as text, the few VFD glyphs outside ASCII shown as their nearest printable character
+static void PrintText(int first, int count) {
+	for (int i = first; i < first + count; i++) {
+		unsigned char c = (unsigned char)G[i];
+		if (c == 0xB5) c = 'u';					// Micro
+		else if (c == 0xB0) c = 'o';			// Degree
+		else if (c < 0x20 || c > 0x7E) c = '~';
+		putchar(c);
+	}
+}
+
+
+int main(int argc, char** argv) {
+	const char* ppm = NULL;
+	_Bool quiet = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "qo:")) != -1) {
+		switch (opt) {
+		case 'q':	quiet = true; break;
+		case 'o':	ppm = optarg; break;
+		default:	optind = argc + 1; break;
+		}
+	}
+	if (optind != argc - 1) {
+		fprintf(stderr, "usage: %s [-q] [-o screen.ppm] frames.vfdr\n", argv[0]);
+		return 2;
+	}
+
+	FILE* f = fopen(argv[optind], "rb");
+	if (f == NULL) {
+		perror(argv[optind]);
+		return 1;
+	}
+
+	SimBoot();
+	vfdReplayMode = 1;
+
+	ReplayTotals total = { 0 };
+	uint32_t lastRenderTick = HAL_GetTick();
+	uint64_t startNs = simNs;
+	uint32_t firstTick = 0;
+	uint8_t entry[VFDR_ENTRY_SIZE];
+
+	if (!quiet) printf("%10s %1s %9s %9s %6s %5s  %-18s  %-29s  %s\n",
+		"tick", "", "decode us", "render us", "bytes", "CS", "main", "aux", "annunciators");
+
+	while (fread(entry, 1, VFDR_ENTRY_SIZE, f) == VFDR_ENTRY_SIZE) {
+		uint32_t tick = entry[0] | (entry[1] << 8) | (entry[2] << 16) | ((uint32_t)entry[3] << 24);
+		if (total.frames == 0) firstTick = tick;
+
+		// The recording's time line, from the end of the boot. Frames closer together than the render took arrive
+		// late, as they would have been picked up late on the board.
+		uint64_t due = startNs + (uint64_t)(tick - firstTick) * 1000000ULL;
+		if (due > simNs) SimHal_Advance(due - simNs);
+
+		memcpy(vfdReplayFrame, entry + 4, VFDR_FRAME_SIZE);
+		vfdReplayRequest++;
+		total.frames++;
+
+		// The main loop's decode, in its order
+		VFD_CaptureReplayPoll();
+
+		uint32_t frameSeq;
+		_Bool newFrame = (framesDecoded == 0);
+		while (VFD_FrameQueuePop(&frameSeq)) {
+			newFrame = true;
+		}
+
+		char what = '=';
+		uint64_t decodeNs = 0;
+		if (newFrame) {
+			VFD_CaptureAcquire();
+			_Bool changed = VFD_CaptureChanged();
+
+			if (changed || framesDecoded == 0) {
+				uint64_t t = CpuNs();
+				Packets_to_chars();
+				Main_Aux_R6581();
+				decodeNs = CpuNs() - t;
+
+				framesDecoded++;
+				renderPending = true;
+				what = 'D';
+				total.decoded++;
+				total.decodeNs += decodeNs;
+				if (decodeNs > total.decodeMaxNs) total.decodeMaxNs = decodeNs;
+			}
+		}
+
+		// The main loop's render scheduling
+		uint32_t now = HAL_GetTick();
+		_Bool renderDue = renderPending && (now - lastRenderTick >= renderMinIntervalMs);
+		_Bool refreshDue = (now - lastRenderTick >= renderMaxIdleMs);
+
+		uint64_t renderNs = 0;
+		uint32_t bytes = 0;
+		uint32_t cs = 0;
+		if (renderDue || refreshDue) {
+			renderPending = false;
+			lastRenderTick = now;
+
+			SimBus from = simBus;
+			uint64_t t = CpuNs();
+			RenderPass(true);
+			LT_DisplayListWait();
+			uint64_t ns = CpuNs() - t;
+			uint64_t modelNs = simBus.modelNs - from.modelNs;
+			renderNs = ns > modelNs ? ns - modelNs : 0;
+			bytes = simBus.bytes - from.bytes;
+			cs = simBus.transactions - from.transactions;
+
+			what = renderDue ? 'R' : 'r';
+			total.rendered++;
+			total.renderNs += renderNs;
+			if (renderNs > total.renderMaxNs) total.renderMaxNs = renderNs;
+			total.spiBytes += bytes;
+			total.spiTransactions += cs;
+		}
+
+		if (!quiet) {
+			printf("%10lu %c %9.1f %9.1f %6lu %5lu  ", (unsigned long)tick, what, decodeNs / 1000.0, renderNs / 1000.0,
+				(unsigned long)bytes, (unsigned long)cs);
+			PrintText(1, LINE1_LEN);
+			printf("  ");
+			PrintText(1 + LINE1_LEN, LINE2_LEN);
+			printf("  ");
+			for (int i = 1; i <= 18; i++) putchar(Annunc[i] ? '*' : '.');
+			putchar('\n');
+		}
+	}
+	fclose(f);
+
+	printf("%lu frames, %lu decoded, %lu CRC hits, %lu renders\n", (unsigned long)total.frames,
+		(unsigned long)total.decoded, (unsigned long)vfdCrcHits, (unsigned long)total.rendered);
+	if (total.decoded > 0) {
+		printf("decode: mean %.1f us, max %.1f us\n", total.decodeNs / 1000.0 / total.decoded,
+			total.decodeMaxNs / 1000.0);
+	}
+	if (total.rendered > 0) {
+		printf("render: mean %.1f us, max %.1f us, SPI1 %lu bytes / %lu CS per render\n",
+			total.renderNs / 1000.0 / total.rendered, total.renderMaxNs / 1000.0,
+			(unsigned long)(total.spiBytes / total.rendered), (unsigned long)(total.spiTransactions / total.rendered));
+	}
+
+	if (ppm != NULL) {
+		if (LtModel_WritePpm(ppm) != 0) {
+			fprintf(stderr, "vfdreplay: cannot write %s\n", ppm);
+			return 1;
+		}
+		printf("Screen written to %s\n", ppm);
+	}
+
+	return 0;
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Decode a raw VFD frame recording captured from the display board's USART2 (PA2, 921600 8N1).
+
+Build the firmware with VFD_RECORD_ENABLE 1 (Core/Inc/vfdrecord.h) and log the serial port to a file, e.g.
+    stty -F /dev/ttyUSB0 921600 raw && cat /dev/ttyUSB0 > session.bin
+
+Then:
+    vfd_record_decode.py session.bin                 summary of every record
+    vfd_record_decode.py session.bin -o frames.vfdr  also write the frames out for replay
+
+Record layout (little-endian), see vfdrecord.h:
+    0xA5, type, tick (u32 ms), seq (u16), body, check (XOR of every byte after 0xA5)
+    type 0x01 FRAME:  body = 235 raw frame bytes
+    type 0x02 REPEAT: body = count (u16), the previous frame was received 'count' more times
+
+The .vfdr output is one entry per received frame, repeats expanded: tick (u32) + 235 frame bytes. Each frame can
+be written into vfdReplayFrame[] (bump vfdReplayRequest) to feed it back through the firmware.
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = 0xA5
+FRAME = 0x01
+REPEAT = 0x02
+FRAME_SIZE = 235    # PACKET_WIDTH * PACKET_COUNT
+HEADER = struct.Struct('<BIH')    # type, tick, seq (after the sync byte)
+
+
+def xor(data):
+    c = 0
+    for b in data:
+        c ^= b
+    return c
+
+
+def records(data):
+    """Yield (type, tick, seq, body), resynchronising on the 0xA5 byte after any damage."""
+    i = 0
+    bad = 0
+    while i < len(data):
+        if data[i] != SYNC:
+            i += 1
+            bad += 1
+            continue
+        if i + 1 + HEADER.size > len(data):
+            break
+        rtype, tick, seq = HEADER.unpack_from(data, i + 1)
+        body_len = FRAME_SIZE if rtype == FRAME else 2 if rtype == REPEAT else None
+        if body_len is None:
+            i += 1
+            bad += 1
+            continue
+        end = i + 1 + HEADER.size + body_len
+        if end >= len(data):
+            break
+        if xor(data[i + 1:end]) != data[end]:
+            i += 1
+            bad += 1
+            continue
+        yield rtype, tick, seq, data[i + 1 + HEADER.size:end]
+        i = end + 1
+    if bad:
+        print(f'skipped {bad} bytes while resynchronising', file=sys.stderr)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument('recording', help='raw bytes logged from the serial port')
+    ap.add_argument('-o', '--output', help='write the frames (repeats expanded) to a .vfdr replay file')
+    ap.add_argument('-q', '--quiet', action='store_true', help='totals only')
+    args = ap.parse_args()
+
+    with open(args.recording, 'rb') as f:
+        data = f.read()
+
+    out = open(args.output, 'wb') if args.output else None
+    last = None
+    last_seq = None
+    frames = repeats = gaps = 0
+
+    for rtype, tick, seq, body in records(data):
+        if rtype == FRAME:
+            last = bytes(body)
+            count = 1
+            frames += 1
+            if not args.quiet:
+                print(f'{tick:10d} ms  seq {seq:5d}  FRAME   {last[:10].hex()}...')
+        else:
+            (count,) = struct.unpack('<H', body)
+            repeats += count
+            if not args.quiet:
+                print(f'{tick:10d} ms  seq {seq:5d}  REPEAT  x{count}')
+            if last is None:
+                continue    # Recording started part way through a run
+
+        # Sequence numbers run on through repeats, a jump means frames were decoded-over or dropped
+        if last_seq is not None and rtype == FRAME and seq != (last_seq + 1) & 0xFFFF:
+            gaps += 1
+        last_seq = seq
+
+        if out:
+            for _ in range(count):
+                out.write(struct.pack('<I', tick) + last)
+
+    if out:
+        out.close()
+    print(f'{frames} frames, {repeats} repeats, {gaps} sequence gaps', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()